@@ -0,0 +1,133 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/assets.hpp>
+#include <cstring>
+
+#include "headless_platform.hpp"
+
+#define BUNDLED_FONT_PATH BRLS_ASSET("font/switch_font.ttf")
+
+HeadlessVideoContext::HeadlessVideoContext()
+{
+    NVGparams params;
+    std::memset(&params, 0, sizeof(params));
+
+    params.userPtr              = this;
+    params.edgeAntiAlias        = 1;
+    params.renderCreate         = renderCreate;
+    params.renderCreateTexture  = renderCreateTexture;
+    params.renderDeleteTexture  = renderDeleteTexture;
+    params.renderUpdateTexture  = renderUpdateTexture;
+    params.renderGetTextureSize = renderGetTextureSize;
+    params.renderViewport       = [](void*, float, float, float) {};
+    params.renderCancel         = [](void*) {};
+    params.renderFlush          = [](void*) {};
+    params.renderFill           = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, const float*, const NVGpath*, int) {};
+    params.renderStroke         = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, float, const NVGpath*, int) {};
+    params.renderTriangles      = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, const NVGvertex*, int, float) {};
+    params.renderDelete         = [](void*) {};
+
+    this->nvgContext = nvgCreateInternal(&params);
+
+    if (!this->nvgContext)
+        brls::fatal("Unable to init the headless nanovg context");
+}
+
+HeadlessVideoContext::~HeadlessVideoContext()
+{
+    if (this->nvgContext)
+        nvgDeleteInternal(this->nvgContext);
+}
+
+int HeadlessVideoContext::renderCreate(void*)
+{
+    return 1;
+}
+
+int HeadlessVideoContext::renderCreateTexture(void* uptr, int, int w, int h, int, const unsigned char*)
+{
+    auto* self = (HeadlessVideoContext*)uptr;
+
+    int image             = ++self->lastTexture;
+    self->textures[image] = { w, h };
+    return image;
+}
+
+int HeadlessVideoContext::renderDeleteTexture(void* uptr, int image)
+{
+    auto* self = (HeadlessVideoContext*)uptr;
+    return self->textures.erase(image) > 0;
+}
+
+int HeadlessVideoContext::renderUpdateTexture(void* uptr, int image, int, int, int, int, const unsigned char*)
+{
+    auto* self = (HeadlessVideoContext*)uptr;
+    return self->textures.count(image) > 0;
+}
+
+int HeadlessVideoContext::renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+    auto* self = (HeadlessVideoContext*)uptr;
+
+    auto it = self->textures.find(image);
+    if (it == self->textures.end())
+        return 0;
+
+    *w = it->second.width;
+    *h = it->second.height;
+    return 1;
+}
+
+void HeadlessInputManager::updateUnifiedControllerState(brls::ControllerState* state)
+{
+    std::memset(state, 0, sizeof(brls::ControllerState));
+}
+
+void HeadlessInputManager::updateControllerState(brls::ControllerState* state, int)
+{
+    std::memset(state, 0, sizeof(brls::ControllerState));
+}
+
+void HeadlessFontLoader::loadFonts()
+{
+    if (!this->loadFontFromFile(brls::FONT_REGULAR, BUNDLED_FONT_PATH))
+        brls::Logger::warning("Failed to load the bundled font, text will not be measured");
+}
+
+HeadlessPlatform::HeadlessPlatform()
+{
+    this->audioPlayer  = new brls::NullAudioPlayer();
+    this->videoContext = new HeadlessVideoContext();
+    this->inputManager = new HeadlessInputManager();
+    this->imeManager   = new HeadlessImeManager();
+    this->fontLoader   = new HeadlessFontLoader();
+}
+
+HeadlessPlatform::~HeadlessPlatform()
+{
+    delete this->fontLoader;
+    delete this->imeManager;
+    delete this->inputManager;
+    delete this->videoContext;
+    delete this->audioPlayer;
+}
+
+void HeadlessPlatform::createWindow(std::string, uint32_t width, uint32_t height, float, float)
+{
+    // There is no window, the content size is applied right away
+    brls::Application::setWindowSize((int)width, (int)height);
+}
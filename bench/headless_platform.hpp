@@ -0,0 +1,145 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis.hpp>
+#include <borealis/core/video.hpp>
+#include <unordered_map>
+
+// A video context without a window nor a GPU: nanovg runs on top of
+// a backend that only keeps track of the textures sizes and discards
+// every draw call, so that layout, text shaping and glyph rasterization
+// still happen on the CPU like they would in the real app
+class HeadlessVideoContext : public VideoContext
+{
+  public:
+    HeadlessVideoContext();
+    ~HeadlessVideoContext() override;
+
+    void clear(NVGcolor) override { }
+    void beginFrame() override { }
+    void endFrame() override { }
+    void resetState() override { }
+    double getScaleFactor() override { return 1.0; }
+    NVGcontext* getNVGContext() override { return this->nvgContext; }
+
+    /**
+     * Number of textures currently alive in the backend
+     */
+    size_t getTexturesCount() const { return this->textures.size(); }
+
+  private:
+    struct Texture
+    {
+        int width;
+        int height;
+    };
+
+    NVGcontext* nvgContext = nullptr;
+    int lastTexture        = 0;
+    std::unordered_map<int, Texture> textures;
+
+    static int renderCreate(void* uptr);
+    static int renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data);
+    static int renderDeleteTexture(void* uptr, int image);
+    static int renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data);
+    static int renderGetTextureSize(void* uptr, int image, int* w, int* h);
+};
+
+class HeadlessInputManager : public brls::InputManager
+{
+  public:
+    short getControllersConnectedCount() override { return 0; }
+    void updateUnifiedControllerState(brls::ControllerState* state) override;
+    void updateControllerState(brls::ControllerState* state, int controller) override;
+    bool getKeyboardKeyState(brls::BrlsKeyboardScancode) override { return false; }
+    void updateTouchStates(std::vector<brls::RawTouchState>*) override { }
+    void updateMouseStates(brls::RawMouseState*) override { }
+    void sendRumble(unsigned short, unsigned short, unsigned short) override { }
+};
+
+class HeadlessImeManager : public brls::ImeManager
+{
+  public:
+    bool openForText(std::function<void(std::string)>, std::string, std::string, int, std::string, int) override
+    {
+        return false;
+    }
+
+    bool openForNumber(std::function<void(long)>, std::string, std::string, int, std::string, std::string, std::string, int) override
+    {
+        return false;
+    }
+};
+
+// Only loads the bundled font, so that the results don't depend
+// on the fonts installed on the machine
+class HeadlessFontLoader : public brls::FontLoader
+{
+  public:
+    void loadFonts() override;
+};
+
+// A platform without window nor inputs, to run views in benchmarks
+class HeadlessPlatform : public brls::Platform
+{
+  public:
+    HeadlessPlatform();
+    ~HeadlessPlatform() override;
+
+    void createWindow(std::string title, uint32_t width, uint32_t height, float windowXPos, float windowYPos) override;
+    std::string getName() override { return "Headless"; }
+
+    bool canShowBatteryLevel() override { return false; }
+    bool canShowWirelessLevel() override { return false; }
+    int getWirelessLevel() override { return 0; }
+    std::string getIpAddress() override { return ""; }
+    std::string getDnsServer() override { return ""; }
+    int getBatteryLevel() override { return 100; }
+    bool isBatteryCharging() override { return false; }
+
+    void disableScreenDimming(bool, const std::string&, const std::string&) override { }
+    bool isScreenDimmingDisabled() override { return false; }
+    void setBacklightBrightness(float) override { }
+    float getBacklightBrightness() override { return 1.0f; }
+    bool canSetBacklightBrightness() override { return false; }
+
+    bool mainLoopIteration() override { return true; }
+    brls::ThemeVariant getThemeVariant() override { return this->themeVariant; }
+    void setThemeVariant(brls::ThemeVariant theme) override { this->themeVariant = theme; }
+    std::string getLocale() override { return brls::LOCALE_EN_US; }
+
+    brls::AudioPlayer* getAudioPlayer() override { return this->audioPlayer; }
+    VideoContext* getVideoContext() override { return this->videoContext; }
+    brls::InputManager* getInputManager() override { return this->inputManager; }
+    brls::ImeManager* getImeManager() override { return this->imeManager; }
+    brls::FontLoader* getFontLoader() override { return this->fontLoader; }
+
+    bool isApplicationMode() override { return true; }
+    void exitToHomeMode(bool) override { }
+    void forceEnableGamePlayRecording() override { }
+    void openBrowser(std::string) override { }
+
+  private:
+    brls::ThemeVariant themeVariant = brls::ThemeVariant::LIGHT;
+
+    brls::NullAudioPlayer* audioPlayer = nullptr;
+    HeadlessVideoContext* videoContext = nullptr;
+    HeadlessInputManager* inputManager = nullptr;
+    HeadlessImeManager* imeManager     = nullptr;
+    HeadlessFontLoader* fontLoader     = nullptr;
+};
@@ -0,0 +1,583 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Self-timed benchmarks of the view tree, printed as JSON on stdout.
+// Everything runs without a window or GPU (see HeadlessPlatform), so the
+// results only measure the CPU side of borealis: XML inflation, layout,
+// text measurement, recycling, focus navigation, texture caching,
+// translations and resource lookups.
+
+#include <algorithm>
+#include <atomic>
+#include <borealis.hpp>
+#include <borealis/core/cache_helper.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <nlohmann/json.hpp>
+#include <random>
+#ifdef USE_LIBROMFS
+#include <romfs/romfs.hpp>
+#endif
+#include <string>
+#include <vector>
+
+#include "headless_platform.hpp"
+
+using namespace brls;
+
+// Heap allocations made by the threads counting them, see benchIdleFrames()
+static std::atomic<size_t> allocations { 0 };
+static thread_local bool countingAllocations = false;
+
+void* operator new(std::size_t size)
+{
+    if (countingAllocations)
+        allocations++;
+
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Number of times the tree benchmarks are repeated
+static size_t repeat = 5;
+
+// Divides the size of every benchmark, for quick runs
+static size_t divisor = 1;
+
+static size_t scaled(size_t size)
+{
+    return std::max<size_t>(1, size / divisor);
+}
+
+template <typename F>
+static Time measure(F&& work)
+{
+    Time start = getCPUTimeUsec();
+    work();
+    return getCPUTimeUsec() - start;
+}
+
+static nlohmann::json summarize(const std::string& name, size_t size, std::vector<Time> samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    Time total = 0;
+    for (Time sample : samples)
+        total += sample;
+
+    return {
+        { "name", name },
+        { "size", size },
+        { "iterations", samples.size() },
+        { "total_us", total },
+        { "mean_us", samples.empty() ? 0.0 : (double)total / samples.size() },
+        { "median_us", samples.empty() ? 0 : samples[samples.size() / 2] },
+        { "min_us", samples.empty() ? 0 : samples.front() },
+        { "max_us", samples.empty() ? 0 : samples.back() },
+    };
+}
+
+// Draws the view through the headless nanovg context
+static void drawFrame(View* view)
+{
+    NVGcontext* vg = Application::getNVGContext();
+
+    FrameContext frameContext;
+    frameContext.vg         = vg;
+    frameContext.pixelRatio = 1.0f;
+    frameContext.theme      = Application::getTheme();
+
+    nvgBeginFrame(vg, Application::windowWidth, Application::windowHeight, 1.0f);
+    view->frame(&frameContext);
+    nvgEndFrame(vg);
+}
+
+static nlohmann::json benchInflateDeep(size_t depth)
+{
+    std::string xml;
+    for (size_t i = 0; i < depth; i++)
+        xml += "<brls:Box axis=\"column\" padding=\"1\">";
+    xml += "<brls:Label text=\"leaf\"/>";
+    for (size_t i = 0; i < depth; i++)
+        xml += "</brls:Box>";
+
+    std::vector<Time> samples;
+    for (size_t i = 0; i < repeat; i++)
+    {
+        View* view = nullptr;
+        samples.push_back(measure([&]
+            {
+                view = View::createFromXMLString(xml);
+                view->setDimensions(Application::contentWidth, Application::contentHeight); }));
+        delete view;
+    }
+
+    return summarize("xml_inflate_deep", depth, samples);
+}
+
+static nlohmann::json benchInflateWide(size_t width)
+{
+    std::string xml = "<brls:Box axis=\"column\">";
+    for (size_t i = 0; i < width; i++)
+        xml += "<brls:Label text=\"Item #" + std::to_string(i) + "\"/>";
+    xml += "</brls:Box>";
+
+    std::vector<Time> samples;
+    for (size_t i = 0; i < repeat; i++)
+    {
+        View* view = nullptr;
+        samples.push_back(measure([&]
+            {
+                view = View::createFromXMLString(xml);
+                view->setDimensions(Application::contentWidth, Application::contentHeight); }));
+        delete view;
+    }
+
+    return summarize("xml_inflate_wide", width, samples);
+}
+
+static nlohmann::json benchRelayout(size_t sections, size_t items, size_t changes)
+{
+    Box* root  = new Box(Axis::COLUMN);
+    View* leaf = nullptr;
+
+    for (size_t i = 0; i < sections; i++)
+    {
+        Box* section = new Box(Axis::ROW);
+
+        for (size_t j = 0; j < items; j++)
+        {
+            Box* item = new Box(Axis::COLUMN);
+            item->setWidth(60);
+
+            Label* label = new Label();
+            label->setText(std::to_string(i) + "." + std::to_string(j));
+            item->addView(label);
+
+            section->addView(item);
+            leaf = item;
+        }
+
+        root->addView(section);
+    }
+
+    root->setDimensions(Application::contentWidth, Application::contentHeight);
+
+    // Every change dirties the path from the leaf to the root,
+    // which is laid out again right away
+    std::vector<Time> samples;
+    for (size_t i = 0; i < changes; i++)
+        samples.push_back(measure([&]
+            { leaf->setWidth(i % 2 ? 60 : 80); }));
+
+    delete root;
+
+    return summarize("relayout_leaf", sections * items, samples);
+}
+
+static nlohmann::json benchLabels(size_t count)
+{
+    std::vector<Time> samples;
+    for (size_t i = 0; i < repeat; i++)
+    {
+        Box* root = new Box(Axis::COLUMN);
+        samples.push_back(measure([&]
+            {
+                for (size_t j = 0; j < count; j++)
+                {
+                    Label* label = new Label();
+                    label->setText("Label #" + std::to_string(j) + " with a few more words to measure");
+                    root->addView(label);
+                }
+                root->setDimensions(Application::contentWidth, Application::contentHeight); }));
+        delete root;
+    }
+
+    return summarize("labels", count, samples);
+}
+
+class BenchCell : public RecyclerCell
+{
+  public:
+    BenchCell()
+    {
+        this->setHeight(44);
+        this->label = new Label();
+        this->addView(this->label);
+    }
+
+    Label* label;
+};
+
+class BenchDataSource : public RecyclerDataSource
+{
+  public:
+    explicit BenchDataSource(size_t rows)
+        : rows(rows)
+    {
+    }
+
+    int numberOfRows(RecyclerFrame*, int) override
+    {
+        return (int)this->rows;
+    }
+
+    RecyclerCell* cellForRow(RecyclerFrame* recycler, IndexPath index) override
+    {
+        BenchCell* cell = (BenchCell*)recycler->dequeueReusableCell("Cell");
+        cell->label->setText("Row #" + std::to_string(index.row));
+        return cell;
+    }
+
+    float heightForRow(RecyclerFrame*, IndexPath) override
+    {
+        return 44;
+    }
+
+  private:
+    size_t rows;
+};
+
+static nlohmann::json benchRecycler(size_t rows)
+{
+    RecyclerFrame* recycler = (RecyclerFrame*)RecyclerFrame::create();
+    recycler->registerCell("Cell", []()
+        { return new BenchCell(); });
+
+    // The rows frames are computed on the first layout
+    std::vector<Time> reload = { measure([&]
+        {
+            recycler->setDataSource(new BenchDataSource(rows));
+            recycler->setDimensions(Application::contentWidth, Application::contentHeight);
+            drawFrame(recycler); }) };
+
+    // Scroll through the whole list one page at a time,
+    // cells are recycled when the frame is drawn
+    float page = recycler->getHeight();
+    float end  = rows * 44.0f - page;
+
+    std::vector<Time> samples;
+    for (float y = page; y < end; y += page)
+        samples.push_back(measure([&]
+            {
+                recycler->setContentOffsetY(y, false);
+                drawFrame(recycler); }));
+
+    delete recycler;
+
+    return nlohmann::json::array({
+        summarize("recycler_reload", rows, reload),
+        summarize("recycler_scroll", rows, samples),
+    });
+}
+
+static nlohmann::json benchFocusGrid(size_t rows, size_t columns)
+{
+    Box* grid   = new Box(Axis::COLUMN);
+    View* first = nullptr;
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        Box* row = new Box(Axis::ROW);
+        for (size_t j = 0; j < columns; j++)
+        {
+            Box* cell = new Box();
+            cell->setDimensions(10, 10);
+            cell->setFocusable(true);
+            row->addView(cell);
+
+            if (!first)
+                first = cell;
+        }
+        grid->addView(row);
+    }
+
+    grid->setDimensions(Application::contentWidth, Application::contentHeight);
+    Application::giveFocus(first);
+
+    // Walk the grid like a snake, so every cell is focused once
+    std::vector<Time> samples;
+    for (size_t i = 0; i < rows; i++)
+    {
+        ControllerButton direction = i % 2 ? BUTTON_NAV_LEFT : BUTTON_NAV_RIGHT;
+        for (size_t j = 1; j < columns; j++)
+            samples.push_back(measure([&]
+                { Application::onControllerButtonPressed(direction, false); }));
+
+        if (i + 1 < rows)
+            samples.push_back(measure([&]
+                { Application::onControllerButtonPressed(BUTTON_NAV_DOWN, false); }));
+    }
+
+    delete grid;
+
+    return summarize("focus_grid", rows * columns, samples);
+}
+
+static nlohmann::json benchTextureCache(size_t keys, size_t lookups)
+{
+    NVGcontext* vg      = Application::getNVGContext();
+    TextureCache& cache = TextureCache::instance();
+    std::vector<unsigned char> pixels(64 * 64 * 4, 0xFF);
+
+    // More keys than the cache can hold, so that textures keep being evicted
+    std::minstd_rand random(42);
+    size_t misses = 0;
+
+    std::vector<Time> samples;
+    for (size_t i = 0; i < lookups; i++)
+    {
+        std::string key = "bench/texture/" + std::to_string(random() % keys);
+        samples.push_back(measure([&]
+            {
+                int texture = cache.getCache(key);
+                if (texture == 0)
+                {
+                    misses++;
+                    texture = nvgCreateImageRGBA(vg, 64, 64, 0, pixels.data());
+                    cache.addCache(key, texture);
+                }
+                cache.removeCache(texture); }));
+    }
+
+    nlohmann::json json = summarize("texture_cache_churn", keys, samples);
+    json["misses"]       = misses;
+    json["memory_bytes"] = cache.getMemoryUsage();
+    json["textures"]     = ((HeadlessVideoContext*)Application::getPlatform()->getVideoContext())->getTexturesCount();
+    return json;
+}
+
+static nlohmann::json benchI18n(size_t lookups)
+{
+    // Found at various depths of the demo translations, plus a missing one
+    const char* names[] = {
+        "hints/ok",
+        "hints/exit_hint",
+        "demo/title",
+        "demo/tabs/components",
+        "demo/components/button_primary",
+        "demo/missing/string",
+    };
+    size_t count = sizeof(names) / sizeof(names[0]);
+
+    // The buffer is reused like a label refreshed every frame would
+    std::string buffer;
+    size_t found = 0;
+
+    std::vector<Time> samples;
+    for (size_t i = 0; i < repeat; i++)
+        samples.push_back(measure([&]
+            {
+                for (size_t j = 0; j < lookups; j++)
+                {
+                    const char* name = names[j % count];
+                    if (getStrTo(buffer, name) != name)
+                        found++;
+                } }));
+
+    nlohmann::json json = summarize("i18n_lookup", lookups, samples);
+    json["found"]        = found / repeat;
+    return json;
+}
+
+// Times the given format function, and counts the heap allocations it makes
+template <typename F>
+static nlohmann::json benchI18nFormat(const std::string& name, size_t formats, F&& format)
+{
+    std::vector<Time> samples;
+    size_t length = 0;
+
+    allocations         = 0;
+    countingAllocations = true;
+
+    for (size_t i = 0; i < repeat; i++)
+        samples.push_back(measure([&]
+            {
+                for (size_t j = 0; j < formats; j++)
+                    length += format(j); }));
+
+    countingAllocations = false;
+
+    nlohmann::json json = summarize(name, formats, samples);
+    json["allocations"] = allocations.load() / repeat;
+    json["length"]      = length / repeat;
+    return json;
+}
+
+static std::vector<nlohmann::json> benchI18nFormats(size_t formats)
+{
+    const char* items   = "demo/bench/items";
+    const char* itemsIn = "demo/bench/items_in";
+    std::string folder  = "Downloads";
+
+    std::vector<nlohmann::json> results;
+
+    // Pre-split format strings, into a reused buffer
+    std::string buffer;
+    results.push_back(benchI18nFormat("i18n_format_getstrto", formats, [&](size_t n)
+        { return getStrTo(buffer, items, n).size() + getStrTo(buffer, itemsIn, n, folder).size(); }));
+
+    // Pre-split format strings, into a new string every time
+    results.push_back(benchI18nFormat("i18n_format_getstr", formats, [&](size_t n)
+        { return getStr(items, n).size() + getStr(itemsIn, n, folder).size(); }));
+
+    // Baseline: the raw translation formatted at runtime, as done before the strings were split
+    results.push_back(benchI18nFormat("i18n_format_runtime", formats, [&](size_t n)
+        {
+            std::string_view raw   = internal::findRawStr(items);
+            std::string_view rawIn = internal::findRawStr(itemsIn);
+            return fmt::format(fmt::runtime(raw), n).size() + fmt::format(fmt::runtime(rawIn), n, folder).size(); }));
+
+    return results;
+}
+
+static nlohmann::json benchIdleFrames(size_t frames)
+{
+    Box* root = new Box(Axis::COLUMN);
+    root->setDimensions(Application::contentWidth, Application::contentHeight);
+
+    Box* content = new Box(Axis::COLUMN);
+    for (size_t i = 0; i < 50; i++)
+    {
+        Button* button = new Button();
+        button->setText("Button #" + std::to_string(i));
+        content->addView(button);
+    }
+
+    ScrollingFrame* scrolling = new ScrollingFrame();
+    scrolling->setGrow(1.0f);
+    scrolling->setContentView(content);
+    root->addView(scrolling);
+
+    // The first activity cannot be popped, this benchmark has to run last
+    Application::pushActivity(new Activity(root), TransitionAnimation::NONE);
+
+    // Let the construction, the layout and the focus animations settle
+    for (size_t i = 0; i < 120; i++)
+        Application::mainLoop();
+
+    // Nothing changes from one frame to the next: drawing must not allocate
+    std::vector<Time> samples;
+    samples.reserve(frames);
+
+    allocations         = 0;
+    countingAllocations = true;
+
+    for (size_t i = 0; i < frames; i++)
+        samples.push_back(measure([&]
+            { Application::mainLoop(); }));
+
+    countingAllocations = false;
+
+    nlohmann::json json  = summarize("idle_frame", frames, samples);
+    json["allocations"] = allocations.load();
+    return json;
+}
+
+#ifdef USE_LIBROMFS
+static nlohmann::json benchRomfs(size_t lookups)
+{
+    std::vector<std::string> paths;
+    for (const auto& path : romfs::list())
+        paths.push_back(path.generic_string());
+
+    // One lookup out of ten misses, like probing for an optional resource
+    for (size_t i = 0; i < paths.size() / 10 + 1; i++)
+        paths.push_back("missing/" + std::to_string(i) + ".png");
+
+    size_t found = 0;
+
+    std::vector<Time> samples;
+    for (size_t i = 0; i < repeat; i++)
+        samples.push_back(measure([&]
+            {
+                for (size_t j = 0; j < lookups; j++)
+                {
+                    if (romfs::find(paths[j % paths.size()]))
+                        found++;
+                } }));
+
+    nlohmann::json json = summarize("romfs_lookup", lookups, samples);
+    json["resources"]    = romfs::list().size();
+    json["found"]        = found / repeat;
+    return json;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+    Logger::setLogLevel(LogLevel::LOG_ERROR);
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) // Number of repetitions
+            repeat = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "-q") == 0) // Quick run, with 10 times smaller trees
+            divisor = 10;
+        else if (std::strcmp(argv[i], "-d") == 0)
+            Logger::setLogLevel(LogLevel::LOG_DEBUG);
+    }
+
+    if (!Application::init(new HeadlessPlatform()))
+        return EXIT_FAILURE;
+
+    Application::createWindow("borealis_bench");
+
+    nlohmann::json results = nlohmann::json::array();
+    results.push_back(benchInflateDeep(scaled(100)));
+    results.push_back(benchInflateWide(scaled(1000)));
+    results.push_back(benchRelayout(scaled(50), 20, 200));
+    results.push_back(benchLabels(scaled(10000)));
+    for (auto& result : benchRecycler(scaled(100000)))
+        results.push_back(result);
+    results.push_back(benchFocusGrid(scaled(100), 100));
+    results.push_back(benchTextureCache(1000, 20000));
+    results.push_back(benchI18n(scaled(100000)));
+    for (auto& result : benchI18nFormats(scaled(100000)))
+        results.push_back(result);
+#ifdef USE_LIBROMFS
+    results.push_back(benchRomfs(scaled(100000)));
+#endif
+
+    nlohmann::json idle = benchIdleFrames(scaled(1000));
+    results.push_back(idle);
+
+    std::printf("%s\n", nlohmann::json({ { "benchmarks", results } }).dump(4).c_str());
+
+    Threading::stop();
+
+    if (idle["allocations"] != 0)
+    {
+        std::fprintf(stderr, "Idle frames made %zu heap allocations, expected none\n", idle["allocations"].get<size_t>());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -36,6 +36,10 @@ using namespace brls::literals; // for _i18n
 
 int main(int argc, char* argv[])
 {
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool partialRedraw     = false;
+
     // We recommend to use INFO for real apps
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "-d") == 0) { // Set log level
@@ -45,6 +49,12 @@ int main(int argc, char* argv[])
             brls::Logger::setLogOutput(std::fopen(path, "w+"));
         } else if (std::strcmp(argv[i], "-v") == 0) {
             brls::Application::enableDebuggingView(true);
+        } else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) { // Record input
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc) { // Replay recorded input, print frame times as JSON and quit
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-x") == 0) { // Only redraw the damaged areas, and flash them
+            partialRedraw = true;
         }
     }
 
@@ -57,6 +67,12 @@ int main(int argc, char* argv[])
 
     brls::Application::createWindow("demo/title"_i18n);
 
+    if (partialRedraw)
+    {
+        brls::Application::setPartialRedrawEnabled(true);
+        brls::Application::setRepaintFlashEnabled(true);
+    }
+
     brls::Application::getPlatform()->setThemeVariant(brls::ThemeVariant::DARK);
 
     // Have the application register an action on every activity that will quit when you press BUTTON_START
@@ -84,6 +100,16 @@ int main(int argc, char* argv[])
     // Create and push the main activity to the stack
     brls::Application::pushActivity(new MainActivity());
 
+    if (recordPath)
+        brls::Application::startInputRecording(recordPath);
+
+    if (replayPath && brls::Application::startInputReplay(replayPath))
+        brls::Application::getInputReplayFinishedEvent()->subscribe([](brls::FrameTimeReport report)
+            {
+                // Print the results for scripts comparing runs
+                std::printf("%s\n", report.toJSON().c_str());
+                brls::Application::quit(); });
+
     // Run the app
     while (brls::Application::mainLoop())
         ;
@@ -60,6 +60,12 @@ option(SIMPLE_HIGHLIGHT "Simple highlight" OFF)
 # https://cmake.org/cmake/help/latest/prop_tgt/UNITY_BUILD.html
 option(BRLS_UNITY_BUILD "Unity build" OFF)
 
+# Build borealis_bench, which times the view tree without a window and prints the results as JSON
+cmake_dependent_option(BRLS_BENCH "Build the headless benchmarks" OFF "PLATFORM_DESKTOP" OFF)
+
+# Build borealis_i18n, which compiles the translations of a locale to a binary catalog
+cmake_dependent_option(BRLS_I18N_COMPILER "Build the translations catalog compiler" OFF "PLATFORM_DESKTOP;NOT USE_LIBROMFS" OFF)
+
 
 if (NOT DEFINED APP_PLATFORM_INCLUDE)
     set(APP_PLATFORM_INCLUDE)
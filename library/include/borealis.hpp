@@ -45,6 +45,7 @@
 #include <borealis/core/view.hpp>
 
 // Views
+#include <borealis/views/animated_image.hpp>
 #include <borealis/views/applet_frame.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/dialog.hpp>
@@ -55,6 +56,7 @@
 #include <borealis/views/progress_spinner.hpp>
 #include <borealis/views/rectangle.hpp>
 #include <borealis/views/recycler.hpp>
+#include <borealis/views/scroll_view.hpp>
 #include <borealis/views/scrolling_frame.hpp>
 #include <borealis/views/h_scrolling_frame.hpp>
 #include <borealis/views/sidebar.hpp>
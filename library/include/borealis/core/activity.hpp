@@ -16,17 +16,18 @@
 
 #pragma once
 
+#include <borealis/core/time.hpp>
 #include <borealis/core/view.hpp>
 
 namespace brls
 {
 
 #define CONTENT_FROM_XML_RES(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLResource(x); }
+    brls::View* createContentView() override { return this->createContentFromXMLDocument(brls::View::loadXMLResource(x)); }
 #define CONTENT_FROM_XML_FILE(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLFile(x); }
+    brls::View* createContentView() override { return this->createContentFromXMLDocument(brls::View::loadXMLFile(x)); }
 #define CONTENT_FROM_XML_STR(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLString(x); }
+    brls::View* createContentView() override { return this->createContentFromXMLDocument(brls::View::loadXMLString(x)); }
 
 // An activity is a "screen" of your app in which the library adds
 // the UI components. The app is made of a stack of activities, each activity
@@ -72,6 +73,33 @@ class Activity
      */
     virtual void onContentAvailable() {};
 
+    /**
+     * Creates the root view of the given XML document and takes ownership of the document.
+     * The children XML elements are inflated by the first construction steps, before
+     * onContentConstructionStep() is called, so that they can be spread over several
+     * frames with staged construction. Used by the CONTENT_FROM_XML_* macros.
+     *
+     * brls:Box elements are inflated one node per step. Other views handle their
+     * children XML elements themselves, so they are inflated with their whole subtree
+     * in a single step.
+     */
+    View* createContentFromXMLDocument(tinyxml2::XMLDocument* document);
+
+    /**
+     * Called after createContentView() and before onContentAvailable(), until it returns true,
+     * to build the content one piece at a time (adding tabs, filling lists...).
+     *
+     * With staged construction, the steps are spread over several frames. Otherwise,
+     * they are all called when the activity is pushed.
+     */
+    virtual bool onContentConstructionStep() { return true; };
+
+    /**
+     * Returns the view shown while the content is being built, when staged construction is enabled.
+     * Default is a spinner in the middle of the screen.
+     */
+    virtual View* createPlaceholderView();
+
     View* getContentView();
 
     /**
@@ -159,9 +187,79 @@ class Activity
 
     void setAlpha(float alpha);
 
+    /**
+     * Draws the content from a snapshot until unfreezeContent() is called.
+     * Used by the application while the activity is part of a transition.
+     */
+    void freezeContent();
+    void unfreezeContent();
+
+    /**
+     * If set to true, the views created by createContentView() and onContentAvailable(),
+     * as well as the recycler cells of this activity, will be allocated in
+     * a ViewArena owned by the activity. The whole arena is released
+     * when the activity is deleted.
+     *
+     * Must be called before the activity is pushed. Default is false.
+     */
+    void setArenaEnabled(bool enabled);
+
+    /**
+     * Returns the arena of this activity, or nullptr if it's not enabled.
+     */
+    ViewArena* getArena();
+
+    /**
+     * If set to true, pushing the activity shows the placeholder view right away and
+     * builds the content over the next frames, spending at most frameBudget microseconds
+     * per frame (at least one step is run every frame). The content replaces the placeholder
+     * and the transition starts once onContentConstructionStep() returns true.
+     *
+     * Must be called before the activity is pushed. Default is false.
+     */
+    void setStagedConstructionEnabled(bool enabled, Time frameBudget = 8000);
+
+    bool isStagedConstructionEnabled();
+
+    /**
+     * Returns true while the content is being built.
+     */
+    bool isConstructing();
+
+    /**
+     * Returns the time spent building the content, in microseconds.
+     */
+    Time getConstructionTime();
+
+    /**
+     * Called by the application when the activity is pushed: builds the whole content,
+     * or sets the placeholder view if staged construction is enabled.
+     */
+    void beginConstruction();
+
+    /**
+     * Called by the application every frame while the activity is constructing.
+     * Returns true once the content is complete and has replaced the placeholder.
+     */
+    bool continueConstruction();
+
   private:
     View* constructorView = nullptr;
     View* contentView     = nullptr;
+    ViewArena* arena      = nullptr;
+
+    bool stagedConstruction  = false;
+    Time constructionBudget  = 0;
+    bool constructing        = false;
+    View* stagedContentView  = nullptr;
+    Time constructionTime    = 0;
+    size_t constructionSteps = 0;
+
+    // Boxes of the content being inflated, with their next child XML element
+    std::vector<std::pair<Box*, tinyxml2::XMLElement*>> inflatingBoxes;
+
+    void pushInflatingBox(Box* box, tinyxml2::XMLElement* element);
+    void inflateNextXMLElement();
 };
 
 } // namespace brls
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <tweeny.h>
 
+#include <array>
 #include <borealis/core/time.hpp>
 
 namespace brls
@@ -36,6 +37,8 @@ using EasingFunction = tweeny::easing::enumerated;
 // setEndCallback() and setTickCallback() allow you to execute code as long as the animation runs and / or once when it finishes.
 // Use .getValue() to get the current value at any time.
 //
+// Steps are stored inline in the animatable, there can be up to Animatable::MAX_STEPS steps.
+//
 // An animatable has overloads for float conversion, comparison (==) and assignment operator (=) to allow
 // basic usage as a simple float. Assignment operator is a shortcut to the reset() method.
 class Animatable : public FiniteTicking
@@ -75,6 +78,8 @@ class Animatable : public FiniteTicking
      *
      * Duration is int32_t due to internal limitations, so a step cannot last for longer than 2 147 483 647ms.
      * The sum of the duration of all steps cannot exceed 71582min.
+     *
+     * Steps added past MAX_STEPS are ignored.
      */
     void addStep(float targetValue, int32_t duration, EasingFunction easing = EasingFunction::linear);
 
@@ -88,6 +93,8 @@ class Animatable : public FiniteTicking
     void operator=(const float value);
     bool operator==(const float value);
 
+    static constexpr size_t MAX_STEPS = 8;
+
   protected:
     bool onUpdate(Time delta) override;
 
@@ -95,8 +102,23 @@ class Animatable : public FiniteTicking
     void onRewind() override;
 
   private:
+    struct Step
+    {
+        float targetValue;
+        int32_t duration;
+        EasingFunction easing;
+    };
+
     float currentValue = 0.0f;
-    tweeny::tween<float> tween;
+    float initialValue = 0.0f;
+
+    std::array<Step, MAX_STEPS> steps;
+    size_t stepsCount = 0;
+
+    Time totalDuration = 0;
+    Time elapsed       = 0;
+
+    float getValueAt(Time time);
 };
 
 void updateHighlightAnimation();
@@ -23,8 +23,10 @@
 
 #include <borealis/core/activity.hpp>
 #include <borealis/core/audio.hpp>
+#include <borealis/core/buffer.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/frame_context.hpp>
+#include <borealis/core/input_replay.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
 #include <borealis/core/style.hpp>
@@ -71,6 +73,13 @@ class Application
      */
     static bool init();
 
+    /**
+     * Inits the borealis application on the given platform instead of
+     * the one selected by Platform::createPlatform(), for example to run
+     * views without a window. The application takes ownership of it.
+     */
+    static bool init(Platform* platform);
+
     /**
      * Creates the application window with the given title.
      * Must be called after calling init().
@@ -126,6 +135,9 @@ class Application
      * The view will gain focus if applicable.
      *
      * The first activity to be pushed cannot be popped.
+     *
+     * If the activity has staged construction enabled, its placeholder
+     * is shown until the content is built, then the transition starts.
      */
     static void pushActivity(Activity* view, TransitionAnimation animation = TransitionAnimation::FADE);
 
@@ -166,6 +178,13 @@ class Application
      */
     static bool loadFontFromMemory(std::string fontName, void* data, size_t size, bool freeData);
 
+    /**
+     * Loads a font from the given buffer without copying it, and keeps
+     * a reference to the buffer for as long as the font stash uses it.
+     * Returns true if the operation succeeded.
+     */
+    static bool loadFontFromMemory(std::string fontName, const ByteBuffer& data);
+
     /**
      * Returns the nanovg handle to the given font name, or FONT_INVALID if
      * no such font is currently loaded.
@@ -213,6 +232,101 @@ class Application
     static size_t getFPS();
     static void setLimitedFPS(size_t fps);
 
+    /**
+     * Returns the rendering statistics of the last frame (draw calls,
+     * vertices, texture binds and uniform uploads), if the video
+     * context is able to gather them.
+     */
+    static VideoFrameStats getFrameStats();
+
+    /**
+     * Queues the cached layer of the given view to be rendered
+     * before the next frame is drawn. See View::setLayerCached().
+     */
+    static void enqueueLayerRender(View* view);
+
+    /**
+     * Removes the given view from the queued layer renders.
+     */
+    static void cancelLayerRender(View* view);
+
+    /**
+     * Returns a framebuffer of the given size for a cached layer, reusing
+     * a released one when possible. Returns nullptr if the video context
+     * does not support framebuffers.
+     */
+    static VideoFramebuffer* acquireLayerFramebuffer(int width, int height);
+
+    /**
+     * Gives back a framebuffer returned by acquireLayerFramebuffer().
+     * A few window sized ones are kept for the next activity transition
+     * snapshots, the others are deleted.
+     */
+    static void releaseLayerFramebuffer(VideoFramebuffer* framebuffer);
+
+    /**
+     * If set to true, the activities are drawn in an offscreen framebuffer
+     * which is kept between frames, and only the areas damaged since the
+     * previous frame are cleared and drawn again. The focus highlight,
+     * notifications and other overlays are still drawn every frame on top.
+     *
+     * Views report damage the same way they invalidate their cached layer,
+     * see View::invalidateLayer(). Custom views that change without a
+     * layout change or a style setter must call it, otherwise their
+     * new content will not be displayed.
+     *
+     * Falls back to drawing everything every frame if the video context
+     * does not support offscreen framebuffers. Disabled by default.
+     */
+    static void setPartialRedrawEnabled(bool enabled);
+
+    static bool isPartialRedrawEnabled();
+
+    /**
+     * Briefly flashes the areas drawn again by partial redraw, to debug
+     * views damaging too much or not enough of the screen.
+     */
+    static void setRepaintFlashEnabled(bool enabled);
+
+    /**
+     * Marks the given area, in the coordinates used by the views, to be drawn again
+     * by partial redraw. Damage reported while drawing is drawn by the next frame.
+     */
+    static void addDamage(Rect rect);
+
+    /**
+     * Marks the whole window to be drawn again by partial redraw.
+     */
+    static void damageAll();
+
+    /**
+     * Resets the scissor of the given context, use it instead of nvgResetScissor()
+     * in views to stay inside of the area being drawn by partial redraw.
+     */
+    static void resetScissor(NVGcontext* vg);
+
+    /**
+     * Records the input of every frame to the given file, until stopInputRecording()
+     * is called or the application exits. Returns false if the file cannot be opened.
+     */
+    static bool startInputRecording(const std::string& path);
+    static void stopInputRecording();
+
+    /**
+     * Replays an input recording instead of the platform input, advancing the
+     * frame clock by the given fixed step (in microseconds) every frame.
+     *
+     * Once finished, the frame time report is logged and the replay finished event is fired.
+     * Returns false if the recording cannot be loaded.
+     */
+    static bool startInputReplay(const std::string& path, Time fixedStep = 16667);
+    static bool isReplayingInput();
+
+    inline static Event<FrameTimeReport>* getInputReplayFinishedEvent()
+    {
+        return &Application::inputReplayFinishedEvent;
+    }
+
     /**
      * If the value is set to true, the program will limit FPS to Application::DeactivatedFPS
      * after Application::DeactivatedTime milliseconds of inactivity.
@@ -262,8 +376,37 @@ class Application
      */
     static std::string getLocale();
 
+    /**
+     * Adds the view to the deletion pool, it will be deleted
+     * at the end of the frame (or later, if it's locked or if the
+     * deletion budget is exceeded).
+     *
+     * Adding a view that is already in the pool does nothing.
+     */
     static void addToFreeQueue(View* view);
 
+    /**
+     * Sets the maximum time in microseconds spent deleting views every frame.
+     * Remaining views are deleted in the next frames.
+     *
+     * When a budget is set, a Box being deleted also sends its children
+     * to the deletion pool instead of deleting them in cascade.
+     *
+     * 0 means no limit, which is the default.
+     */
+    static void setDeletionBudget(Time budget);
+    static Time getDeletionBudget();
+
+    /**
+     * Returns the number of views waiting in the deletion pool.
+     */
+    static size_t getPendingDeletionCount();
+
+    /**
+     * Returns the number of views deleted during the last frame.
+     */
+    static size_t getLastFrameDeletionCount();
+
     /**
      * Returns the current input type.
      */
@@ -313,13 +456,45 @@ class Application
     inline static std::string title;
 
     inline static FontStash fontStash;
+    inline static std::vector<ByteBuffer> fontBuffers;
 
     inline static std::vector<Activity*> activitiesStack;
+    inline static std::vector<std::pair<Activity*, TransitionAnimation>> constructingActivities;
     inline static std::vector<View*> focusStack;
     inline static std::deque<View*> deletionPool;
+    inline static Time deletionBudget            = 0;
+    inline static size_t lastFrameDeletionCount = 0;
+    inline static VideoFrameStats lastFrameStats;
+    inline static std::vector<View*> pendingLayers;
+    inline static std::vector<View*> renderingLayers;
+    inline static std::vector<VideoFramebuffer*> layerFramebuffers; // released, window sized
+
+    inline static bool partialRedrawEnabled           = false;
+    inline static bool repaintFlashEnabled            = false;
+    inline static bool fullDamage                     = true;
+    inline static bool repainting                     = false;
+    inline static Rect damagedRect                    = Rect();
+    inline static Rect repaintedRect                  = Rect();
+    inline static VideoFramebuffer* screenFramebuffer = nullptr;
+    inline static ThemeVariant damageThemeVariant     = ThemeVariant::LIGHT;
+    inline static std::vector<std::pair<Rect, Time>> repaintFlashes;
+
+    static VideoFramebuffer* prepareScreenFramebuffer(VideoContext* videoContext);
+    static bool snapDamage(Rect* damage, float scaleFactor);
+    static void frameOverlays(FrameContext* frameContext);
+    static void renderPendingLayers(FrameContext* frameContext);
+    static void drawRepaintFlashes(NVGcontext* vg);
+
+    inline static InputRecorder inputRecorder;
+    inline static ReplayInputManager* inputReplay = nullptr;
+    inline static Event<FrameTimeReport> inputReplayFinishedEvent;
+    static void finishInputReplay();
 
     inline static View* currentFocus = nullptr;
     inline static std::vector<TouchState> currentTouchState;
+    inline static std::vector<TouchState> nextTouchState;
+    inline static std::vector<RawTouchState> rawTouchState;
+    inline static std::vector<int> queuedTouches; // fingers set by queued events this frame
     inline static MouseState currentMouseState;
     inline static NotificationManager* notificationManager;
 
@@ -329,10 +504,18 @@ class Application
     inline static InputType inputType = InputType::GAMEPAD;
 
     inline static void processInput();
+    static void processButtonEvent(ControllerButton button, bool pressed, ControllerState* state, ControllerState* oldState);
+    static void dispatchTouchState(TouchState* touch);
     inline static bool internalMainLoop();
 
     inline static void updateFPS();
 
+    static void processDeletionPool();
+
+    static void continueActivitiesConstruction();
+    static void presentActivity(Activity* activity, TransitionAnimation animation);
+    static void unfreezeActivity(Activity* activity);
+
     inline static unsigned blockInputsTokens = 0; // any value > 0 means inputs are blocked
     inline static bool muteSounds            = false;
 
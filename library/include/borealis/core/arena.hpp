@@ -0,0 +1,180 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <yoga/YGNode.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace brls
+{
+
+struct ViewArenaStats
+{
+    size_t bytesAllocated = 0; // sum of all the allocations made in the arena
+    size_t bytesInUse     = 0; // bytes currently used by live views and nodes
+    size_t peakBytesInUse = 0;
+    size_t bytesReserved  = 0; // size of the chunks owned by the arena
+    size_t liveObjects    = 0; // views and yoga nodes currently allocated
+};
+
+// A slab arena for views and their yoga nodes.
+//
+// Memory is taken from big chunks and recycled through per-size free lists,
+// so building and tearing down a screen does not fragment the heap.
+// When the arena is released, the chunks that are empty are freed right away
+// and the others as soon as their last block is freed: a few views that
+// outlive the arena only keep the chunks they are in.
+//
+// Every block has a header, which tells heap blocks apart so that
+// freeing them does not look up the arena chunks.
+//
+// Views are allocated in the arena returned by getCurrent(), use
+// a ViewArena::Scope to select it. Activities can own an arena,
+// see Activity::setArenaEnabled().
+//
+// Arenas must only be used from the main thread.
+class ViewArena
+{
+  public:
+    explicit ViewArena(size_t chunkSize = 64 * 1024);
+
+    /**
+     * Allocates a block of the given size in the arena.
+     * Use ViewArena::deallocate() to free it.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Creates a yoga node in the arena, with the default config.
+     */
+    YGNodeRef createNode();
+
+    /**
+     * Frees a yoga node created by createNode().
+     * Does the same owner / children cleanup as YGNodeFree().
+     */
+    void freeNode(YGNodeRef node);
+
+    /**
+     * Releases the arena. Empty chunks are freed immediately, the others
+     * as soon as the last block allocated in them is freed.
+     *
+     * The arena must not be used after being released.
+     */
+    void release();
+
+    ViewArenaStats getStats() const
+    {
+        return this->stats;
+    }
+
+    /**
+     * Allocates a block in the current arena, or on the heap
+     * if there is none. The block can be freed with deallocate().
+     */
+    static void* allocateInCurrent(size_t size);
+
+    /**
+     * Frees a block allocated by allocate() or allocateInCurrent(),
+     * returning it to the arena that owns it if any.
+     */
+    static void deallocate(void* ptr);
+
+    static ViewArena* getCurrent()
+    {
+        return current;
+    }
+
+    // Selects the current arena until the scope ends
+    class Scope
+    {
+      public:
+        explicit Scope(ViewArena* arena)
+            : previous(current)
+        {
+            current = arena;
+        }
+
+        ~Scope()
+        {
+            current = previous;
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        ViewArena* previous;
+    };
+
+  private:
+    ~ViewArena();
+
+    struct alignas(std::max_align_t) BlockHeader
+    {
+        size_t size; // including header, 0 for heap blocks
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Chunk
+    {
+        ViewArena* arena;
+        size_t size;
+        size_t liveBlocks = 0;
+    };
+
+    using ChunkMap = std::map<const char*, Chunk>;
+
+    char* allocateChunk(size_t size);
+    void* allocateBlock(size_t size);
+    void freeBlock(BlockHeader* header, ChunkMap::iterator chunk);
+    void freeChunk(ChunkMap::iterator chunk);
+
+    /**
+     * Returns the chunk containing the given pointer, or chunks.end()
+     * if it was not allocated in an arena. chunksMutex must be locked.
+     */
+    static ChunkMap::iterator findChunk(const void* ptr);
+
+    size_t chunkSize;
+    char* chunkCursor = nullptr;
+    char* chunkEnd    = nullptr;
+    size_t chunkCount = 0;
+    std::unordered_map<size_t, FreeBlock*> freeLists;
+
+    bool released = false;
+
+    ViewArenaStats stats;
+
+    // Chunks of all the arenas by address, to find the arena owning a block.
+    // Locked since views can be deleted from other threads.
+    inline static ChunkMap chunks;
+    inline static std::mutex chunksMutex;
+
+    // Per thread, so that views created on another thread never land in the UI thread arena
+    inline static thread_local ViewArena* current = nullptr;
+};
+
+} // namespace brls
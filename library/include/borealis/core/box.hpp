@@ -71,6 +71,7 @@ class Box : public View
     View* getNextFocus(FocusDirection direction, View* currentView) override;
     void willAppear(bool resetState) override;
     void willDisappear(bool resetState) override;
+    void willBecomeVisible() override;
     void onWindowSizeChanged() override;
     void onFocusGained() override;
     void onFocusLost() override;
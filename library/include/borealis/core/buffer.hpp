@@ -0,0 +1,108 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brls
+{
+
+// Read-only bytes shared by reference counting, to hand encoded images, fonts
+// and other data from a producer (network, file, romfs...) to a decoder without copying them.
+//
+// Copying or moving a ByteBuffer never copies the bytes: all the copies point to the
+// same memory, which is released when the last one is destroyed.
+// Use ByteBuffer::copy() to duplicate the bytes themselves.
+class ByteBuffer
+{
+  public:
+    // Called once with the wrapped memory when the last reference is released
+    typedef std::function<void(const uint8_t* data, size_t size)> Deleter;
+
+    ByteBuffer() = default;
+
+    /**
+     * Takes ownership of the string, without copying it.
+     */
+    static ByteBuffer fromString(std::string&& data);
+
+    /**
+     * Takes ownership of the vector, without copying it.
+     */
+    static ByteBuffer fromVector(std::vector<uint8_t>&& data);
+
+    /**
+     * Copies the given bytes into a new buffer.
+     */
+    static ByteBuffer copy(const void* data, size_t size);
+
+    /**
+     * Wraps memory owned by someone else (mmap'd file, network library buffer...).
+     * The deleter is called once no ByteBuffer references it anymore.
+     */
+    static ByteBuffer wrap(const void* data, size_t size, Deleter deleter);
+
+    /**
+     * Wraps memory that outlives the application, such as static data.
+     */
+    static ByteBuffer view(const void* data, size_t size);
+
+    /**
+     * Reads the whole file, returns an empty buffer if it cannot be read.
+     */
+    static ByteBuffer fromFile(const std::string& path);
+
+    /**
+     * Returns the given resource: a view of the romfs data if it is enabled,
+     * the content of the file in the resources directory otherwise.
+     * Returns an empty buffer if the resource does not exist.
+     */
+    static ByteBuffer fromRes(const std::string& name);
+
+    const uint8_t* data() const
+    {
+        return this->bytes;
+    }
+
+    size_t size() const
+    {
+        return this->length;
+    }
+
+    bool empty() const
+    {
+        return this->length == 0;
+    }
+
+    std::string_view string() const
+    {
+        return std::string_view((const char*)this->bytes, this->length);
+    }
+
+  private:
+    std::shared_ptr<const void> owner;
+    const uint8_t* bytes = nullptr;
+    size_t length        = 0;
+};
+
+} // namespace brls
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <list>
 #include <stdexcept>
 
 #include "borealis/core/singleton.hpp"
@@ -35,9 +36,17 @@ struct Node
     /// Reference count, 1 for each cache hit
     size_t count = 1;
 
-    Node(K k, T v)
+    /// Memory used by the value, in bytes
+    size_t bytes = 0;
+
+    /// If the value is a texture created with its mip chain
+    bool mipmaps = false;
+
+    Node(K k, T v, size_t bytes, bool mipmaps)
         : key(k)
         , value(v)
+        , bytes(bytes)
+        , mipmaps(mipmaps)
     {
     }
 };
@@ -80,7 +89,7 @@ class LRUCache
         return cacheMap[key]->value;
     }
 
-    void set(K key, T value)
+    void set(K key, T value, size_t bytes = 0, bool mipmaps = false)
     {
         if (isCacheHit(key))
         {
@@ -93,7 +102,8 @@ class LRUCache
             deleteCache(cacheList.size() - capacity);
         }
         // Add new cache
-        cacheList.push_front(Node<K, T>(key, value));
+        cacheList.push_front(Node<K, T>(key, value, bytes, mipmaps));
+        totalBytes += bytes;
 
         // Update the values of two maps
         cacheMap[key]                  = cacheList.begin();
@@ -174,9 +184,24 @@ class LRUCache
 
     std::list<Node<K, T>>& getCacheList() { return cacheList; }
 
+    /**
+     * Memory used by all the cached values, in bytes
+     */
+    size_t getBytes() { return totalBytes; }
+
+    /**
+     * Memory used by the given value, in bytes, 0 if it is not cached
+     */
+    size_t getBytes(T value) { return isExisted(value) ? valueMap[value]->bytes : 0; }
+
+    /**
+     * If the given value was cached with its mip chain
+     */
+    bool hasMipmaps(T value) { return isExisted(value) && valueMap[value]->mipmaps; }
+
     void debug()
     {
-        printf("===== cache size: %zu =====\n", cacheList.size());
+        printf("===== cache size: %zu, %zu bytes =====\n", cacheList.size(), totalBytes);
         for (auto& i : cacheList)
         {
             printf("count: %zu, dirty: %d, value: %zu, key: %s\n", i.count,
@@ -185,7 +210,8 @@ class LRUCache
     }
 
   private:
-    size_t capacity = 1;
+    size_t capacity   = 1;
+    size_t totalBytes = 0;
     T defaultValue;
     std::list<Node<K, T>> cacheList;
     std::unordered_map<K, CacheIter> cacheMap;
@@ -210,6 +236,7 @@ class LRUCache
             {
                 num--;
                 nvgDeleteImage(vg, i->value);
+                totalBytes -= i->bytes;
                 cacheMap.erase(i->key);
                 valueMap.erase(i->value);
                 cacheList.erase(std::next(i).base());
@@ -248,13 +275,44 @@ class TextureCache : public Singleton<TextureCache>
     int getCache(const std::string& key) { return cache.get(key); }
 
     /**
-     * Add cache
+     * Add cache, mipmaps should be true if the texture was created with
+     * its mip chain, after nanovg dropped the flags the backend does not support
      */
-    void addCache(const std::string& key, size_t texture)
+    void addCache(const std::string& key, size_t texture, bool mipmaps = false)
     {
         if (texture <= 0)
             return;
-        cache.set(key, texture);
+
+        int width = 0, height = 0;
+        nvgImageSize(brls::Application::getNVGContext(), texture, &width, &height);
+        cache.set(key, texture, getTextureBytes(width, height, mipmaps), mipmaps);
+    }
+
+    /**
+     * Estimated video memory used by the cached textures, in bytes
+     */
+    size_t getMemoryUsage() { return cache.getBytes(); }
+
+    /**
+     * If the cached texture was added with its mip chain
+     */
+    bool hasMipmaps(size_t texture) { return cache.hasMipmaps(texture); }
+
+    /**
+     * Size of an RGBA texture, including all its mip levels if mipmaps is true
+     */
+    static size_t getTextureBytes(int width, int height, bool mipmaps)
+    {
+        size_t bytes = (size_t)width * height * 4;
+
+        while (mipmaps && (width > 1 || height > 1))
+        {
+            width  = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+            bytes += (size_t)width * height * 4;
+        }
+
+        return bytes;
     }
 
     /**
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
-#include <list>
+#include <iterator>
+#include <vector>
 
 namespace brls
 {
@@ -32,50 +34,192 @@ namespace brls
 // 4. call fire when you want to fire the events
 //    it wil return true if at least one subscriber exists
 //    for that event
+//
+// Callbacks are stored contiguously and called in subscription order, without being copied.
+// Subscribing and unsubscribing from a callback is allowed: subscriptions made while the event
+// fires are only called the next time it fires, and unsubscribed callbacks are removed
+// once the event is done firing.
+//
+// Subscriptions are identified by an id that is never reused, so unsubscribing twice or
+// with an empty subscription does nothing.
 template <typename... Ts>
 class Event
 {
   public:
     typedef std::function<void(Ts...)> Callback;
-    typedef std::list<Callback> CallbacksList;
-    typedef typename CallbacksList::iterator Subscription;
+
+    // Non-owning callback, called with the context given when subscribing
+    typedef void (*RawCallback)(void* context, Ts...);
+
+    struct Subscription
+    {
+        uint64_t id = 0;
+
+        bool isValid() const
+        {
+            return id != 0;
+        }
+    };
 
     Subscription subscribe(Callback cb);
+
+    /**
+     * Subscribes a function pointer and its context, without wrapping them in a std::function.
+     * The context must outlive the subscription.
+     */
+    Subscription subscribe(RawCallback cb, void* context);
+
     void unsubscribe(Subscription subscription);
     void clear();
     bool fire(Ts... args);
 
   private:
-    CallbacksList callbacks;
+    struct Slot
+    {
+        uint64_t id;
+        Callback callback;
+        RawCallback rawCallback = nullptr;
+        void* context           = nullptr;
+        bool removed            = false;
+    };
+
+    // Sorted by id
+    std::vector<Slot> slots;
+
+    // Subscribed while firing, moved to slots when done
+    std::vector<Slot> pendingSlots;
+
+    uint64_t nextId      = 1;
+    unsigned firing      = 0;
+    bool hasRemovedSlots = false;
+
+    Subscription add(Slot slot);
+    void flush();
 };
 
+template <typename... Ts>
+typename Event<Ts...>::Subscription Event<Ts...>::add(Event<Ts...>::Slot slot)
+{
+    slot.id = this->nextId++;
+
+    Subscription subscription;
+    subscription.id = slot.id;
+
+    // Growing the vector while firing would move the callback being called
+    if (this->firing > 0)
+        this->pendingSlots.push_back(std::move(slot));
+    else
+        this->slots.push_back(std::move(slot));
+
+    return subscription;
+}
+
 template <typename... Ts>
 typename Event<Ts...>::Subscription Event<Ts...>::subscribe(Event<Ts...>::Callback cb)
 {
-    this->callbacks.push_back(cb);
-    return --this->callbacks.end();
+    Slot slot;
+    slot.callback = std::move(cb);
+    return this->add(std::move(slot));
+}
+
+template <typename... Ts>
+typename Event<Ts...>::Subscription Event<Ts...>::subscribe(Event<Ts...>::RawCallback cb, void* context)
+{
+    Slot slot;
+    slot.rawCallback = cb;
+    slot.context     = context;
+    return this->add(std::move(slot));
 }
 
 template <typename... Ts>
 void Event<Ts...>::unsubscribe(Event<Ts...>::Subscription subscription)
 {
-    if (this->callbacks.size() > 0)
-        this->callbacks.erase(subscription);
+    if (!subscription.isValid())
+        return;
+
+    auto byId = [](const Slot& slot, uint64_t id) { return slot.id < id; };
+
+    auto it = std::lower_bound(this->slots.begin(), this->slots.end(), subscription.id, byId);
+    if (it != this->slots.end() && it->id == subscription.id)
+    {
+        if (this->firing > 0)
+        {
+            // The callback may be running, keep it alive until the event is done firing
+            it->removed           = true;
+            this->hasRemovedSlots = true;
+        }
+        else
+        {
+            this->slots.erase(it);
+        }
+        return;
+    }
+
+    it = std::lower_bound(this->pendingSlots.begin(), this->pendingSlots.end(), subscription.id, byId);
+    if (it != this->pendingSlots.end() && it->id == subscription.id)
+        this->pendingSlots.erase(it);
 }
 
 template <typename... Ts>
 void Event<Ts...>::clear()
 {
-    this->callbacks.clear();
+    this->pendingSlots.clear();
+
+    if (this->firing > 0)
+    {
+        for (Slot& slot : this->slots)
+            slot.removed = true;
+        this->hasRemovedSlots = true;
+    }
+    else
+    {
+        this->slots.clear();
+    }
+}
+
+template <typename... Ts>
+void Event<Ts...>::flush()
+{
+    if (this->hasRemovedSlots)
+    {
+        this->slots.erase(std::remove_if(this->slots.begin(), this->slots.end(), [](const Slot& slot) { return slot.removed; }), this->slots.end());
+        this->hasRemovedSlots = false;
+    }
+
+    if (!this->pendingSlots.empty())
+    {
+        std::move(this->pendingSlots.begin(), this->pendingSlots.end(), std::back_inserter(this->slots));
+        this->pendingSlots.clear();
+    }
 }
 
 template <typename... Ts>
 bool Event<Ts...>::fire(Ts... args)
 {
-    for (Callback cb : this->callbacks)
-        cb(args...);
+    bool fired = false;
+
+    this->firing++;
+
+    // Slots cannot move while firing, new subscriptions go to pendingSlots
+    size_t count = this->slots.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        Slot& slot = this->slots[i];
+        if (slot.removed)
+            continue;
+
+        if (slot.rawCallback)
+            slot.rawCallback(slot.context, args...);
+        else
+            slot.callback(args...);
+
+        fired = true;
+    }
+
+    if (--this->firing == 0)
+        this->flush();
 
-    return !this->callbacks.empty();
+    return fired;
 }
 
 }; // namespace brls
@@ -116,6 +116,9 @@ struct Rect
 
     // Returns Rect with offset by presented Point.
     Rect offsetBy(const Point& origin) const;
+
+    // Returns the smallest Rect containing both rects, empty rects are ignored.
+    Rect unionWith(const Rect& other) const;
 };
 
 } // namespace brls
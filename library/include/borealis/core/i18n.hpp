@@ -20,6 +20,8 @@
 
 #include <borealis/core/logger.hpp>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace brls
 {
@@ -56,27 +58,98 @@ const std::string LOCALE_DEFAULT = LOCALE_EN_US;
 
 namespace internal
 {
+    // A translated string containing replacement fields, split once
+    // when the translations are loaded: formatting it only appends the
+    // literal parts and formats the arguments
+    struct FormatString
+    {
+        struct Segment
+        {
+            std::string_view literal;
+            std::string field; // "{index:spec}", empty if there is none
+            int argIndex = -1;
+            bool plain   = false; // no format spec
+        };
+
+        std::vector<Segment> segments;
+
+        // Too complex to be split (named or nested fields...),
+        // the whole string is formatted at runtime
+        bool runtime = false;
+    };
+
+    struct TranslatedString
+    {
+        std::string_view text; // null if there is no translation
+        const FormatString* format = nullptr; // null if there are no replacement fields
+    };
+
+    /**
+     * Returns the translation for the given string. The views stay
+     * valid until the translations are loaded again.
+     */
+    TranslatedString findStr(std::string_view stringName);
+
+    /**
+     * Returns the translation for the given string, or a null
+     * string_view if there is none.
+     */
+    std::string_view findRawStr(std::string_view stringName);
+
     std::string getRawStr(std::string stringName);
+
+    void vformatTo(std::string& buffer, const TranslatedString& str, fmt::format_args args);
 } // namespace internal
 
 /**
- * Returns the translation for the given string,
- * after injecting format parameters (if any)
+ * Formats the translation for the given string into buffer, after
+ * injecting format parameters (if any), and returns the buffer.
+ *
+ * The buffer is cleared first but keeps its capacity, reuse
+ * it to format strings every frame without allocating.
  */
 template <typename... Args>
-std::string getStr(std::string stringName, Args&&... args)
+std::string& getStrTo(std::string& buffer, std::string_view stringName, Args&&... args)
 {
-    std::string rawStr = internal::getRawStr(stringName);
+    buffer.clear();
+
+    internal::TranslatedString str = internal::findStr(stringName);
+
+    if (str.text.data() == nullptr)
+    {
+        buffer.append(stringName);
+        return buffer;
+    }
+
+    if (!str.format)
+    {
+        buffer.append(str.text);
+        return buffer;
+    }
 
     try
     {
-        return fmt::format(fmt::runtime(rawStr), args...);
+        internal::vformatTo(buffer, str, fmt::make_format_args(args...));
     }
     catch (const std::exception& e)
     {
-        Logger::error("Invalid format \"{}\" from string \"{}\": {}", rawStr, stringName, e.what());
-        return stringName;
+        Logger::error("Invalid format \"{}\" from string \"{}\": {}", str.text, stringName, e.what());
+        buffer.assign(stringName);
     }
+
+    return buffer;
+}
+
+/**
+ * Returns the translation for the given string,
+ * after injecting format parameters (if any)
+ */
+template <typename... Args>
+std::string getStr(std::string stringName, Args&&... args)
+{
+    std::string str;
+    getStrTo(str, stringName, args...);
+    return str;
 }
 
 /**
@@ -85,6 +158,21 @@ std::string getStr(std::string stringName, Args&&... args)
  */
 void loadTranslations();
 
+/**
+ * Writes the loaded translations (current locale merged with the default one)
+ * to a binary catalog. Ship it as "i18n/<locale>.catalog" in the resources
+ * to have loadTranslations() use it instead of parsing the JSON files.
+ */
+bool saveTranslationsCatalog(const std::string& path);
+
+/**
+ * Compiles the JSON translations of the given locale, merged with the default
+ * one, to a binary catalog. Unlike saveTranslationsCatalog(), it needs neither
+ * the application nor a window: it can run at build time (see borealis_i18n).
+ * Replaces the loaded translations.
+ */
+bool compileTranslationsCatalog(const std::string& locale, const std::string& path);
+
 inline namespace literals
 {
     /**
@@ -22,6 +22,8 @@
 #include <borealis/core/event.hpp>
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/time.hpp>
+#include <array>
+#include <atomic>
 #include <vector>
 
 #define GAMEPADS_MAX 5
@@ -277,7 +279,8 @@ struct TouchState
     int fingerId     = 0;
     TouchPhase phase = TouchPhase::NONE;
     Point position;
-    View* view = nullptr;
+    View* view     = nullptr;
+    Time timestamp = 0; // in microseconds, when the touch was polled or queued
 };
 
 // Contains raw touch data, filled in by platform driver
@@ -302,6 +305,68 @@ struct MouseState
     View* view              = nullptr;
 };
 
+enum class InputEventType
+{
+    BUTTON_DOWN,
+    BUTTON_UP,
+    TOUCH,
+};
+
+// An input event pushed by the platform as soon as it happens, with the time it happened at
+struct InputEvent
+{
+    InputEventType type;
+    Time timestamp = 0; // in microseconds, same clock as getCPUTimeUsec()
+
+    ControllerButton button = BUTTON_A; // BUTTON_DOWN and BUTTON_UP
+    RawTouchState touch; // TOUCH
+};
+
+// Bounded lock-free queue of input events
+// Platforms can push from any thread (input callbacks, event watchers...),
+// the library pops everything from the main thread once per frame.
+// Events pushed while the queue is full are dropped and counted.
+class InputEventQueue
+{
+  public:
+    static constexpr size_t CAPACITY = 256;
+
+    InputEventQueue();
+
+    /**
+     * Pushes an event, returns false if the queue is full.
+     */
+    bool push(const InputEvent& event);
+
+    /**
+     * Pops the oldest event, returns false if the queue is empty.
+     */
+    bool pop(InputEvent* event);
+
+    /**
+     * Drops all the queued events.
+     */
+    void clear();
+
+    /**
+     * Returns the number of events dropped because the queue was full
+     * since the last call, and resets it.
+     */
+    size_t takeDroppedCount();
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        InputEvent event;
+    };
+
+    std::array<Cell, CAPACITY> cells;
+    std::atomic<size_t> pushPosition { 0 };
+    std::atomic<size_t> popPosition { 0 };
+    std::atomic<size_t> droppedCount { 0 };
+};
+
 // Interface responsible for reporting input state to the application - button presses,
 // axis position and touch screen state
 class InputManager
@@ -344,6 +409,24 @@ class InputManager
 
     virtual void setPointerLock(bool lock) {};
 
+    /**
+     * Queues a button press or release, so that it is processed even if it happens
+     * between two frames. The polled state stays the reference for held buttons.
+     * Can be called from any thread.
+     */
+    void pushButtonEvent(ControllerButton button, bool pressed, Time timestamp = 0);
+
+    /**
+     * Queues a touch press or release, so that it is processed even if it happens
+     * between two frames. Can be called from any thread.
+     */
+    void pushTouchEvent(RawTouchState touch, Time timestamp = 0);
+
+    inline InputEventQueue* getEventQueue()
+    {
+        return &eventQueue;
+    }
+
     inline Event<Point>* getMouseCusorOffsetChanged()
     {
         return &mouseCusorOffsetChanged;
@@ -375,7 +458,15 @@ class InputManager
 
     static ControllerButton mapControllerState(ControllerButton button);
 
+    /**
+     * Returns the navigation button triggered by the given d-pad button,
+     * or _BUTTON_MAX if it is not a d-pad button.
+     */
+    static ControllerButton getNavigationButton(ControllerButton button);
+
   private:
+    InputEventQueue eventQueue;
+
     Event<Point> mouseCusorOffsetChanged;
     Event<Point> mouseScrollOffsetChanged;
     Event<KeyState> keyboardKeyStateChanged;
@@ -0,0 +1,144 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/input.hpp>
+#include <borealis/core/video.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// Input of one frame, as polled from the platform.
+// The events timestamps are relative to the frame time.
+struct InputFrame
+{
+    bool buttons[_BUTTON_MAX] = {};
+    float axes[_AXES_MAX]     = {};
+    RawMouseState mouse;
+    std::vector<RawTouchState> touches;
+    std::vector<InputEvent> events;
+};
+
+// Frame time statistics of a replay, in milliseconds,
+// with the average rendering statistics per frame
+struct FrameTimeReport
+{
+    size_t frames = 0;
+    float average = 0;
+    float median  = 0;
+    float p95     = 0;
+    float p99     = 0;
+    float max     = 0;
+
+    float drawCalls    = 0;
+    float vertices     = 0;
+    float textureBinds = 0;
+
+    std::string describe() const;
+
+    /**
+     * Returns the report as a JSON object, to be compared between runs by scripts.
+     */
+    std::string toJSON() const;
+};
+
+// Writes the input polled every frame (controller, touch, mouse and queued events)
+// to a compact binary file, to be replayed by ReplayInputManager.
+class InputRecorder
+{
+  public:
+    ~InputRecorder();
+
+    /**
+     * Starts recording to the given file, returns false if it cannot be opened.
+     */
+    bool start(const std::string& path);
+    void stop();
+
+    bool isRecording() const
+    {
+        return file != nullptr;
+    }
+
+    /**
+     * Called by the application once per frame with the polled input.
+     */
+    void beginFrame(const ControllerState& controller, const std::vector<RawTouchState>& touches, const RawMouseState& mouse);
+    void recordEvent(const InputEvent& event);
+    void endFrame();
+
+  private:
+    FILE* file = nullptr;
+    InputFrame frame;
+};
+
+// Input manager that feeds a recording back, one frame at a time.
+// The application uses it instead of the platform input manager while replaying,
+// with a fixed step frame clock so that animations are identical run to run.
+//
+// The time spent in every frame is collected to build a FrameTimeReport.
+class ReplayInputManager : public InputManager
+{
+  public:
+    explicit ReplayInputManager(InputManager* platformInputManager);
+
+    /**
+     * Loads the given recording, returns false if it cannot be read.
+     */
+    bool load(const std::string& path);
+
+    bool isFinished() const
+    {
+        return currentFrame >= frames.size();
+    }
+
+    /**
+     * Called by the application with the time spent in the last frame, in microseconds,
+     * and its rendering statistics.
+     */
+    void addFrameTime(Time time, const VideoFrameStats& stats);
+
+    FrameTimeReport getReport() const;
+
+    short getControllersConnectedCount() override;
+    void updateUnifiedControllerState(ControllerState* state) override;
+    void updateControllerState(ControllerState* state, int controller) override;
+    bool getKeyboardKeyState(BrlsKeyboardScancode state) override;
+    void updateTouchStates(std::vector<RawTouchState>* states) override;
+    void updateMouseStates(RawMouseState* state) override;
+    void sendRumble(unsigned short controller, unsigned short lowFreqMotor, unsigned short highFreqMotor) override;
+    void runloopStart() override;
+    void drawCursor(NVGcontext* vg) override;
+
+  private:
+    InputManager* platformInputManager;
+
+    std::vector<InputFrame> frames;
+    size_t currentFrame = 0;
+    bool started        = false;
+
+    std::vector<Time> frameTimes;
+    VideoFrameStats totalStats;
+
+    const InputFrame* getFrame() const;
+};
+
+} // namespace brls
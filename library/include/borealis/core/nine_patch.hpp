@@ -0,0 +1,110 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <array>
+#include <map>
+
+namespace brls
+{
+
+// Draws rounded rectangles, rounded borders and view shadows as nine-patches:
+// the corners are rendered once in a texture, then every shape is drawn as
+// nine textured quads in a single draw call instead of tessellated paths.
+//
+// Textures only hold the coverage of the shape, the color is applied when drawing,
+// so they are shared by all colors and themes. They are rendered at the
+// current window scale.
+//
+// All the draw methods return false without drawing anything if the shape
+// is too small to be drawn as a nine-patch, the caller should fall back to
+// regular paths then.
+class NinePatchCache
+{
+  public:
+    /**
+     * Fills a rounded rectangle with the given color.
+     */
+    static bool drawRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius, NVGcolor color);
+
+    /**
+     * Strokes a rounded rectangle with the given color, like nvgStroke()
+     * would with the given stroke width.
+     */
+    static bool drawRoundedBorder(NVGcontext* vg, float x, float y, float width, float height, float radius, float strokeWidth, NVGcolor color);
+
+    /**
+     * Draws the shadow of a view, as View::drawShadow() does.
+     */
+    static bool drawShadow(NVGcontext* vg, float x, float y, float width, float height, float radius,
+        float shadowWidth, float shadowFeather, float shadowOffset, NVGcolor color);
+
+    /**
+     * Deletes all the cached textures.
+     */
+    static void clear(NVGcontext* vg);
+
+    /**
+     * Called once the frame has been flushed, deletes the least recently
+     * used textures if there are more than the cache can hold.
+     */
+    static void endFrame(NVGcontext* vg);
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+  private:
+    enum class PatchType
+    {
+        FILL,
+        BORDER,
+        SHADOW,
+    };
+
+    struct Patch
+    {
+        int image = 0;
+
+        // Size of the borders, in pixels. The center is always one pixel.
+        int left = 0, right = 0, top = 0, bottom = 0;
+
+        // How far the shape goes outside of the given frame
+        float extentLeft = 0, extentRight = 0, extentTop = 0, extentBottom = 0;
+
+        // Index of the last frame the patch was drawn in
+        size_t lastUsedFrame = 0;
+    };
+
+    // type, radius, stroke width or shadow width, feather, offset, pixel scale
+    typedef std::array<float, 6> PatchKey;
+
+    static PatchKey makeKey(PatchType type, float radius, float width, float feather, float offset);
+
+    static Patch renderPatch(NVGcontext* vg, const PatchKey& key);
+
+    static bool drawPatch(NVGcontext* vg, PatchKey key, float x, float y, float width, float height, NVGcolor color);
+
+    static float getPixelScale();
+
+    inline static std::map<PatchKey, Patch> patches;
+    inline static size_t frameIndex = 0;
+    inline static bool enabled = true;
+};
+
+} // namespace brls
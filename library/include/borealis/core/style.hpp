@@ -19,8 +19,9 @@
 #pragma once
 
 #include <initializer_list>
+#include <map>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 namespace brls
 {
@@ -31,10 +32,11 @@ class StyleValues
     StyleValues(std::initializer_list<std::pair<std::string, float>> list);
 
     void addMetric(const std::string&, float value);
-    float getMetric(const std::string& name);
+    float getMetric(std::string_view name);
 
   private:
-    std::unordered_map<std::string, float> values;
+    // Looked up by string_view, without allocating a key while drawing
+    std::map<std::string, float, std::less<>> values;
 };
 
 // Simple wrapper around StyleValues for the array operator
@@ -42,10 +44,10 @@ class Style
 {
   public:
     Style(StyleValues* values);
-    float operator[](const std::string& name);
+    float operator[](std::string_view name);
 
     void addMetric(const std::string& name, float value);
-    float getMetric(const std::string& name);
+    float getMetric(std::string_view name);
 
   private:
     StyleValues* values;
@@ -20,8 +20,9 @@
 #include <nanovg.h>
 
 #include <initializer_list>
+#include <map>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 namespace brls
 {
@@ -38,10 +39,11 @@ class ThemeValues
     ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list);
 
     void addColor(const std::string&, NVGcolor color);
-    NVGcolor getColor(const std::string&);
+    NVGcolor getColor(std::string_view name);
 
   private:
-    std::unordered_map<std::string, NVGcolor> values;
+    // Looked up by string_view, without allocating a key while drawing
+    std::map<std::string, NVGcolor, std::less<>> values;
 };
 
 // Simple wrapper around ThemeValues for the array operator
@@ -49,10 +51,10 @@ class Theme
 {
   public:
     Theme(ThemeValues* values);
-    NVGcolor operator[](const std::string& name);
+    NVGcolor operator[](std::string_view name);
 
     void addColor(const std::string&, NVGcolor color);
-    NVGcolor getColor(const std::string& name);
+    NVGcolor getColor(std::string_view name);
 
     static Theme& getLightTheme();
     static Theme& getDarkTheme();
@@ -35,6 +35,84 @@ inline Time getCPUTimeUsec()
     return cpu_features_get_time_usec();
 }
 
+// Gives every frame a single timestamp, that all the time based code of the frame
+// (tickings, scrolling, gestures velocity...) should read instead of the CPU time so
+// that motion stays consistent with what's presented, whatever the time spent in the frame.
+//
+// When the video context knows its frame interval (vsync), the frame time is the predicted
+// presentation time of the frame: the first vsync after the frame started. The delta between
+// two frames is then always a multiple of the frame interval.
+//
+// In fixed step mode, every frame advances the clock by the same amount whatever the real
+// time is, to make animations deterministic (to replay inputs for instance).
+class FrameClock
+{
+  public:
+    /**
+     * Called internally by the main loop at the start of every frame.
+     */
+    static void beginFrame();
+
+    /**
+     * Called internally by the main loop once the frame has been presented.
+     */
+    static void endFrame();
+
+    /**
+     * Returns the time of the current frame in microseconds.
+     */
+    static Time getFrameTime()
+    {
+        return FrameClock::frameTime;
+    }
+
+    /**
+     * Returns the time elapsed between the previous frame and the current one, in microseconds.
+     */
+    static Time getFrameDelta()
+    {
+        return FrameClock::frameDelta;
+    }
+
+    /**
+     * Returns the number of frames since the application started.
+     */
+    static uint64_t getFrameCount()
+    {
+        return FrameClock::frameCount;
+    }
+
+    /**
+     * Sets the interval between two presented frames in microseconds, 0 if unknown.
+     * Set by the video context according to the display refresh rate and swap interval.
+     */
+    static void setFrameInterval(Time interval);
+
+    static Time getFrameInterval()
+    {
+        return FrameClock::frameInterval;
+    }
+
+    /**
+     * Enables the fixed step mode, every frame will advance the clock by the given
+     * amount of microseconds. 0 disables it (default).
+     */
+    static void setFixedStep(Time step);
+
+    static Time getFixedStep()
+    {
+        return FrameClock::fixedStep;
+    }
+
+  private:
+    inline static Time frameTime       = 0;
+    inline static Time frameDelta      = 0;
+    inline static Time frameInterval   = 0;
+    inline static Time fixedStep       = 0;
+    inline static Time lastPresentTime = 0;
+    inline static uint64_t frameCount  = 0;
+};
+
 typedef std::function<void()> TickingGenericCallback;
 
 typedef std::function<void(bool)> TickingEndCallback;
@@ -44,6 +122,10 @@ typedef TickingGenericCallback TickingTickCallback;
 // like a timer, an animation, a background task...
 // The library manages a list of running tickings. Each ticking is reponsible for managing its own
 // lifetime by returning true or false in onUpdate.
+//
+// Running tickings are kept in slots: a ticking knows its slot, so starting and stopping
+// it is constant time. Stopped tickings leave an empty slot behind, that is reclaimed
+// after the next update.
 class Ticking
 {
   public:
@@ -89,7 +171,16 @@ class Ticking
      */
     static void updateTickings();
 
-    inline static std::vector<Ticking*> runningTickings;
+    /**
+     * Returns the number of running tickings.
+     */
+    static size_t getRunningTickingsCount();
+
+    /**
+     * Returns the running tickings. Tickings stopped since the last
+     * update leave a nullptr in their slot, skip them when iterating.
+     */
+    static const std::vector<Ticking*>& getRunningTickings();
 
   protected:
     /**
@@ -117,6 +208,13 @@ class Ticking
     void stop(bool finished);
 
     bool running = false;
+    size_t slot  = 0;
+
+    // Running tickings, stopped tickings leave a nullptr until the slots are compacted
+    inline static std::vector<Ticking*> runningTickings;
+    inline static size_t runningTickingsCount = 0;
+
+    static void compactTickings();
 
     TickingEndCallback endCallback   = [](bool finished) {};
     TickingTickCallback tickCallback = [] {};
@@ -71,6 +71,9 @@ class PanGestureRecognizer : public GestureRecognizer
     // Get pan gesture axis
     PanAxis getAxis() const { return this->axis; }
 
+    // Set pan gesture axis
+    void setAxis(PanAxis axis) { this->axis = axis; }
+
     // Get current state of recognizer
     PanGestureStatus getCurrentStatus();
 
@@ -87,6 +90,7 @@ class PanGestureRecognizer : public GestureRecognizer
     Point delta;
     PanAxis axis;
     std::vector<Point> posHistory;
+    std::vector<Time> timeHistory;
     GestureState lastState;
 };
 
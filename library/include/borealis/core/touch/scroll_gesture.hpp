@@ -30,6 +30,8 @@ namespace brls
  * 
  * If mouse translation used, the only available state is MOVE.
  * Also PanGestureStatus will be returned with delta values ONLY.
+ * Scrolling wheel events only go to the innermost scroll recognizer under the cursor,
+ * it is up to its view to hand what it does not use to its parents.
  * 
  * TODO: Reimplement scroll events when mouse input will be separated from touch
  */
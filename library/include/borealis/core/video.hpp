@@ -19,6 +19,26 @@
 #include <nanovg.h>
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Rendering statistics of one frame, as reported by the video context
+struct VideoFrameStats
+{
+    size_t drawCalls      = 0;
+    size_t vertices       = 0;
+    size_t textureBinds   = 0;
+    size_t uniformUploads = 0;
+    size_t batchedCalls   = 0; // draw calls saved by merging compatible ones
+};
+
+// An offscreen render target, see VideoContext::createFramebuffer()
+struct VideoFramebuffer
+{
+    int image  = 0; // nanovg image holding the framebuffer content
+    int width  = 0; // in pixels
+    int height = 0;
+};
 
 // A VideoContext is responsible for providing a nanovg context for the app
 // (so by extension it manages all the graphics state as well as the window / context).
@@ -64,6 +84,26 @@ class VideoContext
 
     virtual NVGcontext* getNVGContext() = 0;
 
+    /*
+     * Returns the rendering statistics gathered since the previous call.
+     * Contexts that cannot gather them return empty statistics.
+     */
+    virtual VideoFrameStats getFrameStats() { return {}; }
+
+    /*
+     * Creates an offscreen framebuffer of the given size in pixels.
+     * Returns nullptr if the context does not support them.
+     */
+    virtual VideoFramebuffer* createFramebuffer(int, int) { return nullptr; }
+
+    /*
+     * Redirects the rendering to the given framebuffer, or back
+     * to the window if given nullptr.
+     */
+    virtual void bindFramebuffer(VideoFramebuffer*) { }
+
+    virtual void deleteFramebuffer(VideoFramebuffer*) { }
+
     virtual int getCurrentMonitorIndex() { return 0; };
 
     static inline bool FULLSCREEN = false;
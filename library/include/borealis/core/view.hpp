@@ -27,11 +27,13 @@
 
 #include <borealis/core/actions.hpp>
 #include <borealis/core/animation.hpp>
+#include <borealis/core/arena.hpp>
 #include <borealis/core/event.hpp>
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/core/video.hpp>
 #include <functional>
 #include <memory>
 #include <set>
@@ -274,6 +276,30 @@ class View
     bool wireframeEnabled = false;
     bool clipsToBounds    = false;
 
+    bool layerCached        = false;
+    bool layerDirty         = true;
+    bool layerRendering     = false;
+    bool layerFrozen        = false;
+    bool layerCachedByUser  = false;
+    VideoFramebuffer* layer = nullptr;
+    ThemeVariant layerThemeVariant = ThemeVariant::LIGHT;
+    uint64_t layerRenderFrame      = 0;
+
+    void frameContent(FrameContext* ctx);
+    void getLayerSize(int* width, int* height);
+    void invalidateTranslation();
+    bool isLayerUpToDate();
+    void drawLayer(FrameContext* ctx);
+    void renderLayer(FrameContext* ctx);
+
+    // Where the view was last drawn, in screen space: a layout change
+    // damages that area and the new frame instead of the whole window
+    Rect drawnFrame;
+
+    void invalidateLayout();
+    void damageNewLayout();
+    void damageFrame(Rect frame);
+
     std::vector<Action> actions;
     std::vector<GestureRecognizer*> gestureRecognizers;
 
@@ -333,6 +359,11 @@ class View
 
     int ptrLockCounter = 0;
 
+    ViewArena* arena = nullptr; // arena owning the yoga node, if any
+
+    friend class Application;
+    bool pendingDelete = false; // is the view in the application deletion pool?
+
   protected:
     Animatable collapseState = 1.0f;
 
@@ -389,6 +420,20 @@ class View
     View();
     virtual ~View();
 
+    /**
+     * Views are allocated in the current ViewArena if there is one,
+     * on the heap otherwise.
+     */
+    static void* operator new(size_t size)
+    {
+        return ViewArena::allocateInCurrent(size);
+    }
+
+    static void operator delete(void* ptr)
+    {
+        ViewArena::deallocate(ptr);
+    }
+
     void setBackground(ViewBackground background);
 
     void shakeHighlight(FocusDirection direction);
@@ -410,6 +455,9 @@ class View
     *
     * Only methods that change yoga nodes properties should
     * call this method.
+    *
+    * With partial redraw, only the view and the views that moved
+    * or got resized (where they were drawn and where they are now) are damaged.
     */
     virtual void invalidate();
 
@@ -777,6 +825,7 @@ class View
     inline void setLineColor(NVGcolor color)
     {
         this->lineColor = color;
+        this->invalidateLayer();
     }
 
     /**
@@ -838,6 +887,7 @@ class View
     inline void setBorderColor(NVGcolor color)
     {
         this->borderColor = color;
+        this->invalidateLayer();
     }
 
     /**
@@ -846,6 +896,7 @@ class View
     inline void setBorderThickness(float thickness)
     {
         this->borderThickness = thickness;
+        this->invalidateLayer();
     }
 
     inline float getBorderThickness()
@@ -860,6 +911,7 @@ class View
     inline void setCornerRadius(float radius)
     {
         this->cornerRadius = radius;
+        this->invalidateLayer();
     }
 
     inline float getCornerRadius()
@@ -874,6 +926,7 @@ class View
     inline void setShadowType(ShadowType type)
     {
         this->shadowType = type;
+        this->invalidateLayer();
     }
 
     /**
@@ -882,6 +935,7 @@ class View
     inline void setShadowVisibility(bool visible)
     {
         this->showShadow = visible;
+        this->invalidateLayer();
     }
 
     /**
@@ -957,13 +1011,14 @@ class View
     /**
      * Creates a view from the given XML element (node and attributes).
      *
-     * The method handleXMLElement() is executed for each child node in the XML.
+     * The method handleXMLElement() is executed for each child node in the XML,
+     * unless inflateChildren is false.
      *
      * Uses the internal lookup table to instantiate the views.
      * Use registerXMLView() to add your own views to the table so that
      * you can use them in your own XML files.
      */
-    static View* createFromXMLElement(tinyxml2::XMLElement* element);
+    static View* createFromXMLElement(tinyxml2::XMLElement* element, bool inflateChildren = true);
 
     /**
      * Creates a view from the given XML file path.
@@ -987,6 +1042,14 @@ class View
      */
     static View* createFromXMLResource(std::string name);
 
+    /**
+     * Parses the given XML string, file path or resource file name without
+     * creating any view. The caller owns the returned document.
+     */
+    static tinyxml2::XMLDocument* loadXMLString(std::string_view xml);
+    static tinyxml2::XMLDocument* loadXMLFile(std::string path);
+    static tinyxml2::XMLDocument* loadXMLResource(std::string name);
+
     /**
      * Handles a child XML element.
      *
@@ -1313,6 +1376,17 @@ class View
         // Nothing to do
     }
 
+    /**
+      * Called by the parent scroll view when the view
+      * gets close to its visible area, so it can start
+      * loading its content before being seen.
+      * See ScrollView::setPrefetchDistance().
+      */
+    virtual void willBecomeVisible()
+    {
+        // Nothing to do
+    }
+
     /**
       * Called when the show() animation (fade in)
       * ends
@@ -1567,6 +1641,52 @@ class View
         clipsToBounds = value;
     }
 
+    /**
+     * If set to true, the view and its children are rendered once in
+     * an offscreen layer, then drawn as a single textured quad until
+     * the layer is invalidated. Translation and alpha changes do not
+     * invalidate the layer.
+     *
+     * Layout changes, focus changes, the common view animations and
+     * style setters invalidate the layer automatically. Call invalidateLayer()
+     * after any other change, for instance in custom draw() code.
+     *
+     * Anything drawn outside of the view bounds is clipped.
+     * Falls back to regular drawing if the video context does not
+     * support offscreen framebuffers.
+     */
+    void setLayerCached(bool cached);
+
+    bool isLayerCached();
+
+    /**
+     * Marks the cached layers of this view and its parents as outdated,
+     * they will be rendered again. Also reports the view as damaged
+     * when partial redraw is enabled, see damage().
+     */
+    void invalidateLayer();
+
+    /**
+     * Tells the application that the area covered by this view, including
+     * its highlight and shadow, has to be repainted when partial redraw is enabled.
+     * Does nothing otherwise, see Application::setPartialRedrawEnabled().
+     */
+    void damage();
+
+    /**
+     * Renders the view in a cached layer once, and keeps drawing that snapshot
+     * until unfreezeLayer() is called, even if the content changes meanwhile.
+     * Used to animate activities during transitions without drawing their whole tree every frame.
+     */
+    void freezeLayer();
+
+    /**
+     * Resumes live drawing, or regular layer caching if it was enabled before freezeLayer().
+     */
+    void unfreezeLayer();
+
+    bool isLayerFrozen();
+
     virtual AppletFrame* getAppletFrame();
 
     void present(View* view);
@@ -381,7 +381,7 @@ int nvgCreateImage(NVGcontext* ctx, const char* filename, int imageFlags);
 
 // Creates image by loading it from the specified chunk of memory.
 // Returns handle to the image.
-int nvgCreateImageMem(NVGcontext* ctx, int imageFlags, unsigned char* data, int ndata);
+int nvgCreateImageMem(NVGcontext* ctx, int imageFlags, const unsigned char* data, int ndata);
 
 // Creates image from specified image data.
 // Returns handle to the image.
@@ -516,6 +516,12 @@ void nvgFill(NVGcontext* ctx);
 // Fills the current path with current stroke style.
 void nvgStroke(NVGcontext* ctx);
 
+// Draws textured quads with the specified image, multiplied by the specified color.
+// Each quad is 8 floats: x, y, width and height of the quad, followed by the
+// u0, v0, u1, v1 texture coordinates. All the quads are submitted at once,
+// the current path is not affected.
+void nvgImageQuads(NVGcontext* ctx, int image, NVGcolor color, const float* quads, int nquads);
+
 
 //
 // Text
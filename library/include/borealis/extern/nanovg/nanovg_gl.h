@@ -34,6 +34,15 @@ enum NVGcreateFlags {
 	NVG_DEBUG 			= 1<<2,
 };
 
+// Rendering statistics, gathered by the GL backend while flushing.
+typedef struct NVGglFrameStats {
+	int drawCalls;		// Number of glDrawArrays() calls.
+	int vertices;		// Number of vertices submitted by the draw calls.
+	int textureBinds;	// Number of texture binds that reached the driver.
+	int uniformUploads;	// Number of fragment uniform uploads.
+	int batchedCalls;	// Number of calls merged into the previous one.
+} NVGglFrameStats;
+
 #if defined NANOVG_GL2_IMPLEMENTATION
 #  define NANOVG_GL2 1
 #  define NANOVG_GL_IMPLEMENTATION 1
@@ -62,6 +71,9 @@ void nvgDeleteGL2(NVGcontext* ctx);
 int nvglCreateImageFromHandleGL2(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGL2(NVGcontext* ctx, int image);
 
+// Copies the statistics gathered since the previous call and resets them.
+void nvglFrameStatsGL2(NVGcontext* ctx, NVGglFrameStats* stats);
+
 #endif
 
 #if defined NANOVG_GL3
@@ -72,6 +84,9 @@ void nvgDeleteGL3(NVGcontext* ctx);
 int nvglCreateImageFromHandleGL3(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGL3(NVGcontext* ctx, int image);
 
+// Copies the statistics gathered since the previous call and resets them.
+void nvglFrameStatsGL3(NVGcontext* ctx, NVGglFrameStats* stats);
+
 #endif
 
 #if defined NANOVG_GLES2
@@ -82,6 +97,9 @@ void nvgDeleteGLES2(NVGcontext* ctx);
 int nvglCreateImageFromHandleGLES2(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGLES2(NVGcontext* ctx, int image);
 
+// Copies the statistics gathered since the previous call and resets them.
+void nvglFrameStatsGLES2(NVGcontext* ctx, NVGglFrameStats* stats);
+
 #endif
 
 #if defined NANOVG_GLES3
@@ -92,6 +110,9 @@ void nvgDeleteGLES3(NVGcontext* ctx);
 int nvglCreateImageFromHandleGLES3(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGLES3(NVGcontext* ctx, int image);
 
+// Copies the statistics gathered since the previous call and resets them.
+void nvglFrameStatsGLES3(NVGcontext* ctx, NVGglFrameStats* stats);
+
 #endif
 
 // These are additional flags on top of NVGimageFlags.
@@ -276,6 +297,11 @@ struct GLNVGcontext {
 	#endif
 
 	int dummyTex;
+
+	// Last uniform block uploaded during the current flush
+	int lastUniformOffset;
+
+	NVGglFrameStats stats;
 };
 typedef struct GLNVGcontext GLNVGcontext;
 
@@ -301,12 +327,21 @@ static void glnvg__bindTexture(GLNVGcontext* gl, GLuint tex)
 	if (gl->boundTexture != tex) {
 		gl->boundTexture = tex;
 		glBindTexture(GL_TEXTURE_2D, tex);
+		gl->stats.textureBinds++;
 	}
 #else
 	glBindTexture(GL_TEXTURE_2D, tex);
+	gl->stats.textureBinds++;
 #endif
 }
 
+static void glnvg__drawArrays(GLNVGcontext* gl, GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays(mode, first, count);
+	gl->stats.drawCalls++;
+	gl->stats.vertices += count;
+}
+
 static void glnvg__stencilMask(GLNVGcontext* gl, GLuint mask)
 {
 #if NANOVG_GL_USE_STATE_FILTER
@@ -1002,12 +1037,18 @@ static GLNVGfragUniforms* nvg__fragUniformPtr(GLNVGcontext* gl, int i);
 static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
 {
 	GLNVGtexture* tex = NULL;
+
+	// Calls sharing a uniform block only need it uploaded once
+	if (uniformOffset != gl->lastUniformOffset) {
 #if NANOVG_GL_USE_UNIFORMBUFFER
-	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, sizeof(GLNVGfragUniforms));
+		glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, sizeof(GLNVGfragUniforms));
 #else
-	GLNVGfragUniforms* frag = nvg__fragUniformPtr(gl, uniformOffset);
-	glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
+		GLNVGfragUniforms* frag = nvg__fragUniformPtr(gl, uniformOffset);
+		glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
 #endif
+		gl->lastUniformOffset = uniformOffset;
+		gl->stats.uniformUploads++;
+	}
 
 	if (image != 0) {
 		tex = glnvg__findTexture(gl, image);
@@ -1047,7 +1088,7 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 	glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
 	glDisable(GL_CULL_FACE);
 	for (i = 0; i < npaths; i++)
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
 	glEnable(GL_CULL_FACE);
 
 	// Draw anti-aliased pixels
@@ -1061,13 +1102,13 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		// Draw fringes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 
 	// Draw fill
 	glnvg__stencilFunc(gl, GL_NOTEQUAL, 0x0, 0xff);
 	glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
-	glDrawArrays(GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
 
 	glDisable(GL_STENCIL_TEST);
 }
@@ -1081,10 +1122,10 @@ static void glnvg__convexFill(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__checkError(gl, "convex fill");
 
 	for (i = 0; i < npaths; i++) {
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
 		// Draw fringes
 		if (paths[i].strokeCount > 0) {
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 		}
 	}
 }
@@ -1131,14 +1172,14 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__setUniforms(gl, call->uniformOffset + gl->fragSize, call->image);
 		glnvg__checkError(gl, "stroke fill 0");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Draw anti-aliased pixels.
 		glnvg__setUniforms(gl, call->uniformOffset, call->image);
 		glnvg__stencilFunc(gl, GL_EQUAL, 0x00, 0xff);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Clear stencil buffer.
 		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
@@ -1146,7 +1187,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
 		glnvg__checkError(gl, "stroke fill 1");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
 		glDisable(GL_STENCIL_TEST);
@@ -1158,7 +1199,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__checkError(gl, "stroke fill");
 		// Draw Strokes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 }
 
@@ -1167,7 +1208,7 @@ static void glnvg__triangles(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__setUniforms(gl, call->uniformOffset, call->image);
 	glnvg__checkError(gl, "triangles fill");
 
-	glDrawArrays(GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLES, call->triangleOffset, call->triangleCount);
 }
 
 static void glnvg__renderCancel(void* uptr) {
@@ -1255,6 +1296,7 @@ static void glnvg__renderFlush(void* uptr)
 		gl->blendFunc.dstRGB = GL_INVALID_ENUM;
 		gl->blendFunc.dstAlpha = GL_INVALID_ENUM;
 		#endif
+		gl->lastUniformOffset = -1;
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
 		// Upload ubo for frag shaders
@@ -1395,6 +1437,21 @@ static GLNVGfragUniforms* nvg__fragUniformPtr(GLNVGcontext* gl, int i)
 	return (GLNVGfragUniforms*)&gl->uniforms[i];
 }
 
+// Shares the previous uniform block if the one just allocated at
+// uniformOffset holds the same values, and returns the offset to use.
+static int glnvg__shareFragUniforms(GLNVGcontext* gl, int uniformOffset)
+{
+	int previous = uniformOffset - gl->fragSize;
+	if (previous < 0 || uniformOffset != (gl->nuniforms - 1) * gl->fragSize)
+		return uniformOffset;
+
+	if (memcmp(nvg__fragUniformPtr(gl, previous), nvg__fragUniformPtr(gl, uniformOffset), sizeof(GLNVGfragUniforms)) != 0)
+		return uniformOffset;
+
+	gl->nuniforms--;
+	return previous;
+}
+
 static void glnvg__vset(NVGvertex* vtx, float x, float y, float u, float v)
 {
 	vtx->x = x;
@@ -1480,6 +1537,7 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 		if (call->uniformOffset == -1) goto error;
 		// Fill shader
 		glnvg__convertPaint(gl, nvg__fragUniformPtr(gl, call->uniformOffset), paint, scissor, fringe, fringe, -1.0f);
+		call->uniformOffset = glnvg__shareFragUniforms(gl, call->uniformOffset);
 	}
 
 	return;
@@ -1536,6 +1594,7 @@ static void glnvg__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperati
 		call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
 		if (call->uniformOffset == -1) goto error;
 		glnvg__convertPaint(gl, nvg__fragUniformPtr(gl, call->uniformOffset), paint, scissor, strokeWidth, fringe, -1.0f);
+		call->uniformOffset = glnvg__shareFragUniforms(gl, call->uniformOffset);
 	}
 
 	return;
@@ -1572,6 +1631,21 @@ static void glnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 	frag = nvg__fragUniformPtr(gl, call->uniformOffset);
 	glnvg__convertPaint(gl, frag, paint, scissor, 1.0f, fringe, -1.0f);
 	frag->type = NSVG_SHADER_IMG;
+	call->uniformOffset = glnvg__shareFragUniforms(gl, call->uniformOffset);
+
+	// Merge with the previous call if it draws contiguous triangles with the
+	// same state, typically consecutive runs of text.
+	if (gl->ncalls > 1) {
+		GLNVGcall* prev = &gl->calls[gl->ncalls - 2];
+		if (prev->type == GLNVG_TRIANGLES && prev->image == call->image &&
+			prev->uniformOffset == call->uniformOffset &&
+			prev->triangleOffset + prev->triangleCount == call->triangleOffset &&
+			memcmp(&prev->blendFunc, &call->blendFunc, sizeof(GLNVGblend)) == 0) {
+			prev->triangleCount += call->triangleCount;
+			gl->ncalls--;
+			gl->stats.batchedCalls++;
+		}
+	}
 
 	return;
 
@@ -1712,4 +1786,19 @@ GLuint nvglImageHandleGLES3(NVGcontext* ctx, int image)
 	return tex->tex;
 }
 
+#if defined NANOVG_GL2
+void nvglFrameStatsGL2(NVGcontext* ctx, NVGglFrameStats* stats)
+#elif defined NANOVG_GL3
+void nvglFrameStatsGL3(NVGcontext* ctx, NVGglFrameStats* stats)
+#elif defined NANOVG_GLES2
+void nvglFrameStatsGLES2(NVGcontext* ctx, NVGglFrameStats* stats)
+#elif defined NANOVG_GLES3
+void nvglFrameStatsGLES3(NVGcontext* ctx, NVGglFrameStats* stats)
+#endif
+{
+	GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	*stats = gl->stats;
+	memset(&gl->stats, 0, sizeof(gl->stats));
+}
+
 #endif /* NANOVG_GL_IMPLEMENTATION */
@@ -0,0 +1,44 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/video.hpp>
+
+namespace brls
+{
+
+// Offscreen framebuffers of the OpenGL video contexts, created with nanovg_gl_utils.
+// The nanovg GL implementation itself is compiled by the video context.
+class GLFramebufferManager
+{
+  public:
+    VideoFramebuffer* createFramebuffer(NVGcontext* vg, int width, int height);
+
+    /**
+     * Binds the given framebuffer, or the window again if it is null.
+     * The window viewport is restored when going back to it.
+     */
+    void bindFramebuffer(VideoFramebuffer* framebuffer);
+
+    void deleteFramebuffer(VideoFramebuffer* framebuffer);
+
+  private:
+    bool framebufferBound = false;
+    int windowViewport[4] = {};
+};
+
+} // namespace brls
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <borealis/core/video.hpp>
+#include <borealis/platforms/driver/gl_framebuffer.hpp>
 
 #ifdef __PSV__
 #define GLFW_INCLUDE_ES2
@@ -36,6 +37,10 @@ class GLFWVideoContext : public VideoContext
     ~GLFWVideoContext() override;
 
     NVGcontext* getNVGContext() override;
+    VideoFrameStats getFrameStats() override;
+    VideoFramebuffer* createFramebuffer(int width, int height) override;
+    void bindFramebuffer(VideoFramebuffer* framebuffer) override;
+    void deleteFramebuffer(VideoFramebuffer* framebuffer) override;
 
     void clear(NVGcolor color) override;
     void beginFrame() override;
@@ -51,6 +56,10 @@ class GLFWVideoContext : public VideoContext
     GLFWwindow* window     = nullptr;
     NVGcontext* nvgContext = nullptr;
 
+#ifdef BOREALIS_USE_OPENGL
+    GLFramebufferManager framebuffers;
+#endif
+
 #ifdef __SWITCH__
     int oldWidth, oldHeight;
     GLFWmonitor* monitor = nullptr;
@@ -19,6 +19,7 @@
 #include <SDL2/SDL.h>
 
 #include <borealis/core/video.hpp>
+#include <borealis/platforms/driver/gl_framebuffer.hpp>
 
 namespace brls
 {
@@ -31,6 +32,10 @@ class SDLVideoContext : public VideoContext
     ~SDLVideoContext() override;
 
     NVGcontext* getNVGContext() override;
+    VideoFrameStats getFrameStats() override;
+    VideoFramebuffer* createFramebuffer(int width, int height) override;
+    void bindFramebuffer(VideoFramebuffer* framebuffer) override;
+    void deleteFramebuffer(VideoFramebuffer* framebuffer) override;
 
     void clear(NVGcolor color) override;
     void beginFrame() override;
@@ -45,6 +50,10 @@ class SDLVideoContext : public VideoContext
   private:
     SDL_Window* window     = nullptr;
     NVGcontext* nvgContext = nullptr;
+
+#ifdef BOREALIS_USE_OPENGL
+    GLFramebufferManager framebuffers;
+#endif
 };
 
 } // namespace brls
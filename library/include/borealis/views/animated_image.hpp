@@ -0,0 +1,100 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <borealis/core/timer.hpp>
+#include <borealis/views/image.hpp>
+#include <memory>
+
+namespace brls
+{
+
+class AnimatedImageDecoder;
+
+// An animated GIF. Frames are decoded a few at a time on the async thread
+// into a small ring, and uploaded to a single texture when they are due.
+// Memory use only depends on the image size, not on the number of frames.
+//
+// Playback follows the frame clock and only advances while the view is drawn,
+// so culled or hidden animations do not decode anything. A timer invalidates
+// the view when the next frame is due, so that it is drawn again inside
+// cached layers and with partial redraw. It is paused while the view is hidden
+// or not drawn, and resumed by the next draw.
+// Images that are not GIFs are displayed as a regular Image.
+class AnimatedImage : public Image
+{
+  public:
+    AnimatedImage();
+    ~AnimatedImage();
+
+    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void willAppear(bool resetState = false) override;
+    void willDisappear(bool resetState = false) override;
+
+    /**
+     * Sets the animation from the given resource name.
+     */
+    void setImageFromRes(const std::string& name);
+
+    /**
+     * Sets the animation from the given file path.
+     */
+    void setImageFromFile(const std::string& path);
+
+    /**
+     * Sets the animation from memory. The data is copied.
+     */
+    void setImageFromMem(const unsigned char* data, int size);
+
+    /**
+     * Sets the animation from the given buffer, without copying it.
+     */
+    void setImageFromMem(const ByteBuffer& data) override;
+
+    void clear();
+
+    /**
+     * Resumes or pauses the animation. Animations play by default.
+     */
+    void play();
+    void pause();
+    bool isPlaying();
+
+    static View* create();
+
+  private:
+    std::shared_ptr<AnimatedImageDecoder> decoder;
+    int animationWidth  = 0;
+    int animationHeight = 0;
+
+    bool playing     = true;
+    Time nextFrameAt = 0;
+
+    // Frame time of the last due frame the view has been invalidated for
+    Time invalidatedFrameAt = -1;
+    RepeatingTimer playbackTimer;
+
+    bool setAnimation(const ByteBuffer& data);
+    bool isNextFrameDue();
+    void checkNextFrame();
+    void stopDecoder();
+    void requestFrame();
+    void showNextFrame(NVGcontext* vg);
+};
+
+} // namespace brls
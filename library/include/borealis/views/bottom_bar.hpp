@@ -19,6 +19,7 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/label.hpp>
 
@@ -29,12 +30,16 @@ class BottomBar : public Box
 {
   public:
     BottomBar();
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+
+    void willAppear(bool resetState = false) override;
+    void willDisappear(bool resetState = false) override;
+
     static View* create();
 
   private:
     void updateText();
     std::string bottomText;
+    RepeatingTimer clockTimer;
     BRLS_BIND(Box, hints, "brls/hints");
     BRLS_BIND(Label, time, "brls/hints/time");
     BRLS_BIND(View, battery, "brls/battery");
@@ -19,6 +19,7 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/touch/tap_gesture.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/label.hpp>
 
@@ -28,11 +29,24 @@ namespace brls
 class Hint : public Box
 {
   public:
-    Hint(Action action, bool allowAButtonTouch = false);
+    Hint(const Action& action, bool allowAButtonTouch = false);
     static std::string getKeyIcon(ControllerButton button, bool ignoreKeysSwap = false);
 
+    /**
+     * Changes the action of the hint, the labels are only updated
+     * if the icon, text or availability changed.
+     */
+    void setAction(const Action& action, bool allowAButtonTouch = false);
+
   private:
     Action action;
+    bool tappable = false;
+    bool enabled  = true;
+
+    TapGestureRecognizer* tapRecognizer = nullptr;
+
+    NVGcolor iconColor;
+    NVGcolor hintColor;
 
     BRLS_BIND(Label, icon, "icon");
     BRLS_BIND(Label, hint, "hint");
@@ -67,13 +81,16 @@ class Hints : public Box
     static View* create();
 
   private:
+    std::vector<const Action*> actions;
+    Action unableAButtonAction;
+
     void refillHints(View* focusView);
     bool addUnableAButtonAction = true;
     bool allowAButtonTouch      = false;
     bool forceShown             = false;
 
     VoidEvent::Subscription hintSubscription;
-    static bool actionsSortFunc(Action a, Action b);
+    static bool actionsSortFunc(const Action* a, const Action* b);
 };
 
 } // namespace brls
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <borealis/core/buffer.hpp>
 #include <borealis/core/view.hpp>
 
 namespace brls
@@ -42,7 +43,13 @@ enum class ImageScalingType
 enum class ImageInterpolation
 {
     LINEAR,
-    NEAREST
+    NEAREST,
+    // Linear filtering between mip levels generated once when the texture is created,
+    // for images drawn much smaller than their size: they do not shimmer when
+    // moving and read less texture memory. The mip chain takes a third more memory.
+    TRILINEAR,
+    // TRILINEAR if the laid out view draws the image at less than half of its size, LINEAR otherwise
+    AUTO,
 };
 
 // Alignment of the image inside the view for FIT and CROP scaling types
@@ -59,7 +66,7 @@ enum class ImageAlignment
 // as possible to fit the image. The scaling type dictates
 // what to do with the image if there is not enough or too much space
 // for the view compared to the image inside.
-// Supported formats are: JPG, PNG, TGA, BMP and GIF (not animated).
+// Supported formats are: JPG, PNG, TGA, BMP and GIF (not animated, see AnimatedImage).
 class Image : public View
 {
   public:
@@ -70,11 +77,14 @@ class Image : public View
     void onLayout() override;
 
     /**
-     * Sets the interpolation method for the image. Default is LINEAR.
+     * Sets the interpolation method for the image. Default is AUTO.
      *
      * As the interpolation is set when the texture is created, and since we don't
      * want to always store the image buffer in the view, this only takes effect
      * after (re) loading the image using the setImage* methods.
+     * With AUTO, images set from a file or a resource before the view is laid out are
+     * only decoded after the first layout with a known size, so that they are uploaded once.
+     * Images set from memory are decoded right away and use LINEAR until they are set again.
      *
      * If you are using the interpolation XML attribute, you have to set it before the
      * actual image attribute.
@@ -105,8 +115,25 @@ class Image : public View
      */
     void setImageFromMem(const unsigned char* data, int size);
 
+    /**
+     * Sets the image from the given buffer, without copying it.
+     *
+     * See Image class documentation for the list of supported
+     * image formats.
+     */
+    virtual void setImageFromMem(const ByteBuffer& data);
+
     virtual void innerSetImage(int texture);
 
+    /**
+     * Calls the given function with a callback to give the image data to once it is available,
+     * from any thread. The image is then set on the main thread, if the view still exists.
+     */
+    void setImageAsync(std::function<void(std::function<void(ByteBuffer)>)> cb);
+
+    /**
+     * Same as above, but the data is copied once before being sent to the main thread.
+     */
     void setImageAsync(std::function<void(std::function<void(const std::string&, size_t length)>)> cb);
 
     void clear();
@@ -136,6 +163,12 @@ class Image : public View
     bool getFreeTexture();
 
     int getTexture();
+
+    /**
+     * Returns true if the image size is known but its decoding waits for the view to be laid out.
+     */
+    bool isDecodePending();
+
     float getOriginalImageWidth();
     float getOriginalImageHeight();
 
@@ -144,16 +177,29 @@ class Image : public View
   protected:
     ImageScalingType scalingType     = ImageScalingType::FIT;
     ImageAlignment align             = ImageAlignment::CENTER;
-    ImageInterpolation interpolation = ImageInterpolation::LINEAR;
+    ImageInterpolation interpolation = ImageInterpolation::AUTO;
 
     int texture = 0;
 
     NVGpaint paint;
 
     void invalidateImageBounds();
-    int getImageFlags();
+
+    /**
+     * Returns the nanovg flags to create the texture with, given the size of the source image.
+     * Mipmaps are only chosen by AUTO if that size is known, and never for textures the
+     * backend cannot mipmap, so that the flags match the texture nanovg creates.
+     */
+    int getImageFlags(int sourceWidth = 0, int sourceHeight = 0);
+
     size_t checkCache(const std::string& path);
 
+    /**
+     * Creates the texture from decoded RGBA pixels and frees them.
+     * mipmaps, if given, is set to whether the texture has a mip chain.
+     */
+    int createTexture(unsigned char* pixels, int width, int height, bool* mipmaps);
+
     float originalImageWidth  = 0;
     float originalImageHeight = 0;
 
@@ -163,6 +209,16 @@ class Image : public View
     float imageWidth  = 0;
 
     bool freeTexture = true;
+
+  private:
+    // Path of the image, until AUTO interpolation has been checked against the laid out size
+    std::string pendingAutoPath;
+    bool decodePending = false;
+
+    float getDrawScale(int sourceWidth, int sourceHeight);
+    bool isWaitingForLayout();
+    void deferDecode(int sourceWidth, int sourceHeight);
+    void checkAutoInterpolation();
 };
 
 } // namespace brls
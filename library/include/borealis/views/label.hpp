@@ -18,8 +18,10 @@
 #pragma once
 
 #include <borealis/core/animation.hpp>
+#include <borealis/core/time.hpp>
 #include <borealis/core/timer.hpp>
 #include <borealis/core/view.hpp>
+#include <vector>
 #ifdef OPENCC
 #define Opencc_BUILT_AS_STATIC
 #include <opencc.h>
@@ -173,17 +175,27 @@ class Label : public View
     bool autoAnimate  = true;
     bool animated     = false; // should it animate?
     bool animating    = false; // currently animating?
-    int cursor        = -2;
-    Time cursor_blink = 0;
+    int cursor         = -2;
+    bool cursorVisible = true;
+    RepeatingTimer cursorTimer;
 
-    Timer scrollingTimer;
-    Animatable scrollingAnimation;
+    // Time spent scrolling in ms, advanced by the ticking shared by all the scrolling
+    // labels: the label waits, scrolls the whole text once, then starts over
+    Time scrollingElapsed = 0;
+
+    // Positions of the glyphs of the full text, computed once when scrolling starts
+    // so that only the visible part of the text is drawn. They point into fullText
+    // and depend on the font, so they are cleared whenever one of them changes
+    std::vector<NVGglyphPosition> scrollingGlyphs;
 
     void stopScrollingAnimation();
     void resetScrollingAnimation();
 
+    friend class MarqueeTicking;
+
     void startScrollTimer();
-    void onScrollTimerFinished();
+    float getScrollingOffset(Style style);
+    void drawScrollingText(NVGcontext* vg, float textX, float textY, float minX, float maxX);
 
     HorizontalAlign horizontalAlign = HorizontalAlign::LEFT;
     VerticalAlign verticalAlign     = VerticalAlign::CENTER;
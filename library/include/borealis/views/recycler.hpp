@@ -155,6 +155,19 @@ class RecyclerDataSource
      */
     virtual void didSelectRowAt(RecyclerFrame* recycler, IndexPath index) { }
 
+    /*
+     * Tells the data source a row is about to be displayed, so it can start
+     * loading its data (images...) ahead of time.
+     * Only called if a prefetch distance is set on the recycler frame.
+     */
+    virtual void onPrefetch(RecyclerFrame* recycler, IndexPath index) { }
+
+    /*
+     * Tells the data source a row that has been prefetched left the prefetch
+     * area without being displayed, pending loads can be cancelled.
+     */
+    virtual void cancelPrefetch(RecyclerFrame* recycler, IndexPath index) { }
+
     virtual ~RecyclerDataSource() = default;
 };
 
@@ -254,6 +267,8 @@ class RecyclerFrame : public ScrollingFrame
     Rect renderedFrame;
     std::vector<Size> cacheFramesData;
     std::vector<IndexPath> cacheIndexPathData;
+    std::vector<size_t> prefetchedRows;     // Sorted
+    std::vector<size_t> nextPrefetchedRows; // Reused every tick to compute the next prefetchedRows
     std::map<std::string, std::vector<RecyclerCell*>*> queueMap;
     std::map<std::string, std::function<RecyclerCell*(void)>> allocationMap;
 
@@ -261,6 +276,9 @@ class RecyclerFrame : public ScrollingFrame
 
     void cacheCellFrames();
     void cellsRecyclingLoop();
+    void prefetchContent() override;
+    void prefetchRows();
+    void cancelPrefetching();
     void queueReusableCell(RecyclerCell* cell);
 
     void addCellAt(size_t index, size_t downSide);
@@ -0,0 +1,292 @@
+/*
+    Copyright 2020-2021 natinusala
+    Copyright 2021 XITRIX
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/animation.hpp>
+#include <borealis/core/application.hpp>
+#include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
+#include <borealis/core/touch/scroll_gesture.hpp>
+#include <borealis/views/rectangle.hpp>
+#include <vector>
+
+namespace brls
+{
+
+enum class ScrollingBehavior
+{
+    // Inputs scroll the view like the scroll wheel on a web page, focus changes only when the next view to focus is fully on screen
+    // To work properly, there must be at least one focusable view in the "top" area of the frame (there should not be the need to scroll to see it)
+    NATURAL,
+
+    // The focused view is always in the center, inputs always change focus and scroll immediately
+    CENTERED,
+};
+
+enum class ScrollAxis
+{
+    HORIZONTAL,
+    VERTICAL,
+    BOTH,
+};
+
+// A frame that can scroll on one or both axes if its content overflows.
+// This frame can only contain one child view.
+// The content view is detached from the rest of the tree
+// so that it can grow as much as possible on the scrolling axes.
+//
+// Scrolling only translates the content view, it never triggers a relayout.
+//
+// Scroll views can be nested: the scroll distance a view cannot use
+// (because it reached its limits or does not scroll on that axis) is handed
+// to the closest parent scroll view, for touch, mouse wheel and fling alike.
+class ScrollView : public Box
+{
+  public:
+    ScrollView(ScrollAxis axis = ScrollAxis::VERTICAL);
+    ~ScrollView();
+
+    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onFocusGained() override;
+    void onChildFocusGained(View* directChild, View* focusedView) override;
+    void onChildFocusLost(View* directChild, View* focusedView) override;
+    void willAppear(bool resetState) override;
+    void willDisappear(bool resetState) override;
+    void addView(View* view) override;
+    void removeView(View* view, bool free = true) override;
+    void onLayout() override;
+    void setPadding(float top, float right, float bottom, float left) override;
+    void setPaddingTop(float top) override;
+    void setPaddingRight(float right) override;
+    void setPaddingBottom(float bottom) override;
+    void setPaddingLeft(float left) override;
+    View* getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction) override;
+    View* getNextFocus(FocusDirection direction, View* currentView) override;
+    View* getDefaultFocus() override;
+    enum Sound getFocusSound() override;
+    Rect getVisibleFrame();
+
+    /**
+     * Sets the content view of this scrolling box. There can only be one
+     * content view per scrolling box at a time.
+     */
+    void setContentView(View* view);
+
+    /**
+     * Sets the scrolling behavior of this scrolling frame.
+     * Default is NATURAL.
+     */
+    void setScrollingBehavior(ScrollingBehavior behavior);
+
+    /**
+     * Sets the axes this view scrolls on.
+     */
+    void setScrollAxis(ScrollAxis axis);
+
+    ScrollAxis getScrollAxis() const
+    {
+        return axis;
+    }
+
+    /**
+     * If enabled, flings and touch releases settle on the start of one of
+     * the content view children. The faster the fling, the further it goes.
+     */
+    void setSnapToItems(bool snap)
+    {
+        snapToItems = snap;
+    }
+
+    /**
+     * The point at which the origin of the content view is offset from the origin of the scroll view.
+     */
+    Point getContentOffset() const
+    {
+        return Point(contentOffsetX, contentOffsetY);
+    }
+
+    float getContentOffsetX() const
+    {
+        return contentOffsetX;
+    }
+
+    float getContentOffsetY() const
+    {
+        return contentOffsetY;
+    }
+
+    /**
+     * Sets the offset from the content view’s origin that corresponds to the receiver’s origin.
+     */
+    void setContentOffset(Point value, bool animated);
+    void setContentOffsetX(float value, bool animated);
+    void setContentOffsetY(float value, bool animated);
+
+    /**
+     * Scrolls this view by the given distance, then hands what could not
+     * be scrolled to the closest parent scroll view.
+     */
+    void dispatchNestedScroll(Point delta);
+
+    /**
+     * Same as dispatchNestedScroll() for a fling of the given distance and duration (in ms).
+     */
+    void dispatchNestedFling(Point distance, Point time);
+
+    void setScrollingIndicatorVisible(bool visible)
+    {
+        showScrollingIndicator = visible;
+    }
+
+    /**
+     * Sets how far outside of the visible area content is prefetched.
+     * The area is extended further in the scrolling direction
+     * the faster the view scrolls. 0 disables prefetching (default).
+     *
+     * Children of the content view entering the area get willBecomeVisible().
+     */
+    void setPrefetchDistance(float distance)
+    {
+        prefetchDistance = distance;
+        requestPrefetch();
+    }
+
+    float getPrefetchDistance() const
+    {
+        return prefetchDistance;
+    }
+
+    /**
+     * Returns the prefetch area, in the content view coordinates.
+     */
+    Rect getPrefetchFrame();
+
+    /**
+     * Returns the current scrolling speed, in pixels per second.
+     */
+    Point getScrollVelocity() const
+    {
+        return scrollVelocity;
+    }
+
+    static View* create();
+
+  protected:
+    View* contentView = nullptr;
+
+    Rectangle* horizontalScrollingIndicator = nullptr;
+    Rectangle* verticalScrollingIndicator   = nullptr;
+
+    bool updateScrollingOnNextFrame = false;
+    bool childFocused               = false;
+    bool showScrollingIndicator     = true;
+    bool snapToItems                = false;
+
+    ScrollAxis axis;
+
+    Animatable contentOffsetX = 0.0f;
+    Animatable contentOffsetY = 0.0f;
+
+    // Last viewport size the content view has been laid out for
+    Size contentLayoutSize;
+
+    float prefetchDistance = 0.0f;
+    Point scrollVelocity;
+    Point lastVelocityOffset;
+    Time lastVelocityTime = 0;
+    bool prefetchPending  = false;
+
+    // Children of the content view in the prefetch area, by index: the address of
+    // a deleted view can be reused by a new one. Cleared when the children count changes.
+    std::vector<size_t> prefetchedViews;     // Sorted
+    std::vector<size_t> nextPrefetchedViews; // Reused every tick to compute the next prefetchedViews
+    size_t prefetchedChildrenCount = 0;
+
+    void updateScrollVelocity();
+
+    /**
+     * Called by the scrolling ticking while the content moves, and once after
+     * requestPrefetch(). Gives willBecomeVisible() to the children entering the
+     * prefetch area.
+     */
+    virtual void prefetchContent();
+
+    /**
+     * Runs prefetchContent() on the next frame, for content that changed without scrolling.
+     */
+    void requestPrefetch();
+
+    ScrollGestureRecognizer* scrollGesture = nullptr;
+    Point panStartOffset;
+    Point panOverflow;
+
+    bool canScrollX() const
+    {
+        return axis != ScrollAxis::VERTICAL;
+    }
+
+    bool canScrollY() const
+    {
+        return axis != ScrollAxis::HORIZONTAL;
+    }
+
+    bool updateScrolling(bool animated);
+    void startScrolling(bool animated, bool horizontal, float newScroll);
+    void animateScrolling(bool horizontal, float newScroll, float time);
+    void scrollAnimationTick();
+
+    /**
+     * Scrolls by the given distance and returns the distance that could not be scrolled.
+     */
+    Point scrollBy(Point delta);
+
+    void onPanGesture(PanGestureStatus state);
+
+    float getContentWidth();
+    float getContentHeight();
+
+    // Maximum content offset on the given axis
+    float getScrollLimit(bool horizontal);
+    float findSnapPoint(bool horizontal, float offset);
+    ScrollView* getParentScrollView();
+
+    ScrollingBehavior behavior = ScrollingBehavior::NATURAL;
+    InputManager* input;
+    bool naturalScrollingCanScroll = false;
+    bool naturalScrollingRepeat    = false; // set on border hit to play sound only once
+    void naturalScrollingBehaviour();
+
+    // Runs the natural scrolling, the pending scroll updates, the velocity tracking and
+    // the prefetching every frame while there are some, even if the view is not drawn
+    // (see Application::setPartialRedrawEnabled())
+    RepeatingTimer scrollingTimer;
+    void scrollingTick();
+    bool needsScrollingTick();
+    void startScrollingTick();
+    bool naturalScrollingAxis(const ControllerState& state, bool horizontal);
+    void naturalScrollingButtonProcessing(FocusDirection focusDirection);
+    View* findFirstFocusableView();
+
+    void setupScrollingIndicators();
+    void updateScrollingIndicators();
+
+    Event<InputType>::Subscription inputTypeSubscription;
+};
+
+} // namespace brls
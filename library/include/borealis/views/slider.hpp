@@ -20,6 +20,7 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
 #include <borealis/views/label.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -33,7 +34,8 @@ class Slider : public Box
 
     void onLayout() override;
     View* getDefaultFocus() override;
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onChildFocusGained(View* directChild, View* focusedView) override;
+    void onChildFocusLost(View* directChild, View* focusedView) override;
 
     void setProgress(float progress);
 
@@ -54,6 +56,7 @@ class Slider : public Box
     Rectangle* pointer;
 
     Event<float> progressEvent;
+    RepeatingTimer buttonsTimer;
 
     float progress = 1;
     float step = 0.5f;
@@ -18,6 +18,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -30,17 +31,24 @@ class BatteryWidget : public Box
     BatteryWidget();
 
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void willAppear(bool resetState = false) override;
+    void willDisappear(bool resetState = false) override;
     static View* create();
 
   private:
     Image* back;
     Rectangle* level;
     Platform* platform;
+    RepeatingTimer pollTimer;
+    ThemeVariant appliedTheme = ThemeVariant::LIGHT;
+    bool appliedCharging      = false;
+    float appliedLevel        = 1;
 
     void applyBackTheme(ThemeVariant theme);
     void applyLevelTheme(ThemeVariant theme);
 
     void updateState();
+    void applyState();
     inline static bool isBatteryCharging = false;
     inline static float batteryLevel     = 1;
 };
@@ -18,6 +18,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/timer.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -29,7 +30,9 @@ class WirelessWidget : public Box
   public:
     WirelessWidget();
 
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void willAppear(bool resetState = false) override;
+    void willDisappear(bool resetState = false) override;
+
     static View* create();
 
   private:
@@ -39,10 +42,16 @@ class WirelessWidget : public Box
     Image* _3;
     Image* ethernet;
     Platform* platform;
+    RepeatingTimer pollTimer;
+    bool appliedWireless = false;
+    int appliedLevel     = 3;
+    bool appliedEthernet = false;
 
     void applyTheme(ThemeVariant theme);
 
     void updateState();
+    bool isStateApplied();
+    void applyState();
     inline static bool hasWirelessConnection = false;
     inline static int wifiLevel              = 3;
     inline static bool hasEthernetConnection = false;
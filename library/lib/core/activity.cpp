@@ -17,6 +17,7 @@
 #include <borealis/core/activity.hpp>
 #include <borealis/core/application.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/views/progress_spinner.hpp>
 
 using namespace brls::literals;
 
@@ -61,6 +62,155 @@ View* Activity::createContentView()
     return constructorView;
 }
 
+View* Activity::createPlaceholderView()
+{
+    Box* placeholder = new Box(Axis::COLUMN);
+    placeholder->setJustifyContent(JustifyContent::CENTER);
+    placeholder->setAlignItems(AlignItems::CENTER);
+    placeholder->addView(new ProgressSpinner(ProgressSpinnerSize::LARGE));
+    return placeholder;
+}
+
+void Activity::setStagedConstructionEnabled(bool enabled, Time frameBudget)
+{
+    this->stagedConstruction = enabled;
+    this->constructionBudget = frameBudget;
+}
+
+bool Activity::isStagedConstructionEnabled()
+{
+    return this->stagedConstruction;
+}
+
+bool Activity::isConstructing()
+{
+    return this->constructing;
+}
+
+Time Activity::getConstructionTime()
+{
+    return this->constructionTime;
+}
+
+void Activity::beginConstruction()
+{
+    this->constructionTime  = 0;
+    this->constructionSteps = 0;
+    this->constructing      = true;
+
+    if (this->stagedConstruction)
+    {
+        // Not allocated in the arena: the placeholder is deleted as soon as the content is ready
+        this->setContentView(this->createPlaceholderView());
+        return;
+    }
+
+    // Build everything now, without any time limit
+    this->constructionBudget = 0;
+    while (!this->continueConstruction())
+        ;
+}
+
+bool Activity::continueConstruction()
+{
+    if (!this->constructing)
+        return true;
+
+    Time start = getCPUTimeUsec();
+    bool done  = false;
+
+    // The wall clock budget is ignored while replaying input,
+    // so that the content is presented on the same frame every run
+    Time budget = Application::isReplayingInput() ? 0 : this->constructionBudget;
+
+    {
+        ViewArena::Scope arenaScope(this->arena);
+
+        if (this->constructionSteps == 0)
+        {
+            this->stagedContentView = this->createContentView();
+            this->constructionSteps++;
+        }
+
+        // Run at least one step per frame so that the construction always ends
+        do
+        {
+            // The XML content is inflated before the activity's own steps
+            if (!this->inflatingBoxes.empty())
+                this->inflateNextXMLElement();
+            else
+                done = this->onContentConstructionStep();
+            this->constructionSteps++;
+        } while (!done && (budget == 0 || getCPUTimeUsec() - start < budget));
+
+        if (done)
+        {
+            // Replaces (and deletes) the placeholder, if any
+            if (this->stagedContentView)
+                this->setContentView(this->stagedContentView);
+            this->stagedContentView = nullptr;
+
+            this->onContentAvailable();
+        }
+    }
+
+    this->constructionTime += getCPUTimeUsec() - start;
+
+    if (done)
+    {
+        this->constructing = false;
+        Logger::debug("Activity content constructed in {:.2f}ms ({} steps)", this->constructionTime / 1000.0f, this->constructionSteps);
+    }
+
+    return done;
+}
+
+View* Activity::createContentFromXMLDocument(tinyxml2::XMLDocument* document)
+{
+    tinyxml2::XMLElement* element = document->RootElement();
+
+    // Other views are inflated at once, see inflateNextXMLElement()
+    bool box   = std::string(element->Name()) == "brls:Box";
+    View* view = View::createFromXMLElement(element, !box);
+    view->bindXMLDocument(document);
+
+    if (box)
+        this->pushInflatingBox((Box*)view, element->FirstChildElement());
+
+    return view;
+}
+
+void Activity::pushInflatingBox(Box* box, tinyxml2::XMLElement* element)
+{
+    if (element)
+        this->inflatingBoxes.emplace_back(box, element);
+}
+
+void Activity::inflateNextXMLElement()
+{
+    auto& [parent, element] = this->inflatingBoxes.back();
+
+    Box* box                      = parent;
+    tinyxml2::XMLElement* current = element;
+
+    element = element->NextSiblingElement();
+    if (!element)
+        this->inflatingBoxes.pop_back();
+
+    // Same as Box::handleXMLElement(), without the children of nested boxes:
+    // they are inflated by the next steps, depth first to keep the order
+    if (std::string(current->Name()) == "brls:Box")
+    {
+        Box* child = (Box*)View::createFromXMLElement(current, false);
+        box->addView(child);
+        this->pushInflatingBox(child, current->FirstChildElement());
+    }
+    else
+    {
+        box->addView(View::createFromXMLElement(current));
+    }
+}
+
 float Activity::getShowAnimationDuration(TransitionAnimation animation)
 {
     return contentView->getShowAnimationDuration(animation);
@@ -153,6 +303,36 @@ void Activity::setAlpha(float alpha)
         this->contentView->setAlpha(alpha);
 }
 
+void Activity::freezeContent()
+{
+    if (this->contentView)
+        this->contentView->freezeLayer();
+}
+
+void Activity::unfreezeContent()
+{
+    if (this->contentView)
+        this->contentView->unfreezeLayer();
+}
+
+void Activity::setArenaEnabled(bool enabled)
+{
+    if (enabled && !this->arena)
+    {
+        this->arena = new ViewArena();
+    }
+    else if (!enabled && this->arena)
+    {
+        this->arena->release();
+        this->arena = nullptr;
+    }
+}
+
+ViewArena* Activity::getArena()
+{
+    return this->arena;
+}
+
 View* Activity::getContentView()
 {
     return this->contentView;
@@ -160,14 +340,24 @@ View* Activity::getContentView()
 
 View* Activity::getView(std::string id)
 {
-    if (!this->contentView)
+    if (!this->contentView && !this->stagedContentView)
         return nullptr;
 
+    // Views can be looked up while the content is being built
+    if (this->stagedContentView)
+        return this->stagedContentView->getView(id);
+
     return this->contentView->getView(id);
 }
 
 Activity::~Activity()
 {
+    if (this->stagedContentView)
+    {
+        this->stagedContentView->freeView();
+        this->stagedContentView = nullptr;
+    }
+
     if (this->contentView)
     {
         this->contentView->willDisappear();
@@ -175,6 +365,17 @@ Activity::~Activity()
         this->contentView->freeView();
         this->contentView = nullptr;
     }
+
+    if (this->arena)
+    {
+        ViewArenaStats stats = this->arena->getStats();
+        Logger::debug("Activity arena released: {} bytes allocated, peak {} bytes in use, {} bytes reserved",
+            stats.bytesAllocated, stats.peakBytesInUse, stats.bytesReserved);
+
+        // Chunks are freed once the content view leaves the deletion pool
+        this->arena->release();
+        this->arena = nullptr;
+    }
 }
 
 } // namespace brls
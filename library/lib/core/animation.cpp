@@ -16,11 +16,88 @@
 
 #include <borealis/core/animation.hpp>
 #include <borealis/core/application.hpp>
-#include <vector>
+#include <borealis/core/logger.hpp>
+
+#include <algorithm>
 
 namespace brls
 {
 
+static float ease(EasingFunction easing, float position, float start, float end)
+{
+    using Easing = tweeny::easing;
+
+    switch (easing)
+    {
+        case EasingFunction::linear:
+            return Easing::linear.run(position, start, end);
+        case EasingFunction::stepped:
+            return Easing::stepped.run(position, start, end);
+        case EasingFunction::quadraticIn:
+            return Easing::quadraticIn.run(position, start, end);
+        case EasingFunction::quadraticOut:
+            return Easing::quadraticOut.run(position, start, end);
+        case EasingFunction::quadraticInOut:
+            return Easing::quadraticInOut.run(position, start, end);
+        case EasingFunction::cubicIn:
+            return Easing::cubicIn.run(position, start, end);
+        case EasingFunction::cubicOut:
+            return Easing::cubicOut.run(position, start, end);
+        case EasingFunction::cubicInOut:
+            return Easing::cubicInOut.run(position, start, end);
+        case EasingFunction::quarticIn:
+            return Easing::quarticIn.run(position, start, end);
+        case EasingFunction::quarticOut:
+            return Easing::quarticOut.run(position, start, end);
+        case EasingFunction::quarticInOut:
+            return Easing::quarticInOut.run(position, start, end);
+        case EasingFunction::quinticIn:
+            return Easing::quinticIn.run(position, start, end);
+        case EasingFunction::quinticOut:
+            return Easing::quinticOut.run(position, start, end);
+        case EasingFunction::quinticInOut:
+            return Easing::quinticInOut.run(position, start, end);
+        case EasingFunction::sinusoidalIn:
+            return Easing::sinusoidalIn.run(position, start, end);
+        case EasingFunction::sinusoidalOut:
+            return Easing::sinusoidalOut.run(position, start, end);
+        case EasingFunction::sinusoidalInOut:
+            return Easing::sinusoidalInOut.run(position, start, end);
+        case EasingFunction::exponentialIn:
+            return Easing::exponentialIn.run(position, start, end);
+        case EasingFunction::exponentialOut:
+            return Easing::exponentialOut.run(position, start, end);
+        case EasingFunction::exponentialInOut:
+            return Easing::exponentialInOut.run(position, start, end);
+        case EasingFunction::circularIn:
+            return Easing::circularIn.run(position, start, end);
+        case EasingFunction::circularOut:
+            return Easing::circularOut.run(position, start, end);
+        case EasingFunction::circularInOut:
+            return Easing::circularInOut.run(position, start, end);
+        case EasingFunction::bounceIn:
+            return Easing::bounceIn.run(position, start, end);
+        case EasingFunction::bounceOut:
+            return Easing::bounceOut.run(position, start, end);
+        case EasingFunction::bounceInOut:
+            return Easing::bounceInOut.run(position, start, end);
+        case EasingFunction::elasticIn:
+            return Easing::elasticIn.run(position, start, end);
+        case EasingFunction::elasticOut:
+            return Easing::elasticOut.run(position, start, end);
+        case EasingFunction::elasticInOut:
+            return Easing::elasticInOut.run(position, start, end);
+        case EasingFunction::backIn:
+            return Easing::backIn.run(position, start, end);
+        case EasingFunction::backOut:
+            return Easing::backOut.run(position, start, end);
+        case EasingFunction::backInOut:
+            return Easing::backInOut.run(position, start, end);
+        default:
+            return Easing::def.run(position, start, end);
+    }
+}
+
 Animatable::Animatable(float value)
     : currentValue(value)
 {
@@ -28,7 +105,10 @@ Animatable::Animatable(float value)
 
 void Animatable::onReset()
 {
-    this->tween = tweeny::tween<float>::from(this->currentValue);
+    this->initialValue  = this->currentValue;
+    this->stepsCount    = 0;
+    this->totalDuration = 0;
+    this->elapsed       = 0;
 }
 
 void Animatable::reset(float initialValue)
@@ -44,27 +124,57 @@ void Animatable::reset()
 
 void Animatable::onRewind()
 {
-    this->currentValue = this->tween.seek(0);
+    this->elapsed      = 0;
+    this->currentValue = this->initialValue;
 }
 
 void Animatable::addStep(float targetValue, int32_t duration, EasingFunction easing)
 {
-    this->tween.to(targetValue).during(duration).via(easing);
+    if (this->stepsCount >= MAX_STEPS)
+    {
+        Logger::error("Animatable: cannot add more than {} steps, ignoring step to {}", MAX_STEPS, targetValue);
+        return;
+    }
+
+    this->steps[this->stepsCount++] = { targetValue, duration, easing };
+    this->totalDuration += duration > 0 ? duration : 0;
 }
 
 float Animatable::getProgress()
 {
-    return this->tween.progress();
+    if (this->totalDuration <= 0)
+        return 0.0f;
+
+    return (float)this->elapsed / (float)this->totalDuration;
+}
+
+float Animatable::getValueAt(Time time)
+{
+    float from     = this->initialValue;
+    Time stepStart = 0;
+
+    for (size_t i = 0; i < this->stepsCount; i++)
+    {
+        const Step& step = this->steps[i];
+        Time stepEnd     = stepStart + (step.duration > 0 ? step.duration : 0);
+
+        if (time < stepEnd)
+            return ease(step.easing, (float)(time - stepStart) / (float)step.duration, from, step.targetValue);
+
+        from      = step.targetValue;
+        stepStart = stepEnd;
+    }
+
+    return from;
 }
 
-bool Animatable::onUpdate(retro_time_t delta)
+bool Animatable::onUpdate(Time delta)
 {
-    if (this->tween.progress() >= 1.0f || this->tween.duration() <= 0)
+    if (this->elapsed >= this->totalDuration || this->totalDuration <= 0)
         return false;
-    
-    // int32_t for stepping works as long as the app goes faster than 0.00001396983 FPS
-    // (in which case the delta for a frame wraps in an int32_t)
-    this->currentValue = this->tween.step((int32_t)delta);
+
+    this->elapsed      = std::min(this->elapsed + std::max(delta, (Time)0), this->totalDuration);
+    this->currentValue = this->getValueAt(this->elapsed);
     return true;
 }
 
@@ -104,7 +214,7 @@ void updateHighlightAnimation()
     if (!Application::hasActiveEvent())
         return;
 
-    Time currentTime = getCPUTimeUsec() / 1000;
+    Time currentTime = FrameClock::getFrameTime() / 1000;
 
     // Update variables
     highlightGradientX = (cos((double)currentTime / HIGHLIGHT_SPEED / 3.0) + 1.0) / 2.0;
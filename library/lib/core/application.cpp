@@ -25,9 +25,11 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/nine_patch.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/views/animated_image.hpp>
 #include <borealis/views/bottom_bar.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/cells/cell_bool.hpp>
@@ -56,17 +58,25 @@
 #error Please enable Yoga events with the YG_ENABLE_EVENTS define
 #endif
 
+#include <bitset>
 #include <chrono>
-#include <set>
 #include <thread>
 
 #define BUTTOM_REPEAT_TRIGGER 250000 // 250ms
 #define BUTTON_REPEAT_DELAY   100000 // 100 ms
+#define TOUCH_STATES_RESERVE  16 // touch buffers capacity, grown only if a platform reports more fingers
+#define REPAINT_FLASH_DURATION 300000 // 300ms
+#define LAYER_FRAMEBUFFERS_KEPT 2 // outgoing and incoming activity snapshots of a transition
 
 namespace brls
 {
 
 bool Application::init()
+{
+    return Application::init(Platform::createPlatform());
+}
+
+bool Application::init(Platform* platform)
 {
     Application::inited        = false;
     Application::quitRequested = false;
@@ -77,7 +87,7 @@ bool Application::init()
         Application::ORIGINAL_WINDOW_HEIGHT = 720;
 
     // Init platform
-    Application::platform = Platform::createPlatform();
+    Application::platform = platform;
     Application::notificationManager = new NotificationManager();
 
     if (!Application::platform)
@@ -169,6 +179,7 @@ bool Application::internalMainLoop()
 {
     Application::updateFPS();
     Application::frameStartTime = getCPUTimeUsec();
+    FrameClock::beginFrame();
     Application::setActiveEvent(false);
 
     // Main loop callback
@@ -187,6 +198,7 @@ bool Application::internalMainLoop()
     else
     {
         Logger::verbose("input blocked (tokens={})", Application::blockInputsTokens);
+        Application::platform->getInputManager()->getEventQueue()->clear();
         if (!muteSounds)
             Application::getAudioPlayer()->play(Sound::SOUND_CLICK_ERROR);
     }
@@ -197,6 +209,9 @@ bool Application::internalMainLoop()
 #endif
     Ticking::updateTickings();
 
+    // Build the content of the activities with staged construction
+    Application::continueActivitiesConstruction();
+
     // Render
     Application::frame();
 
@@ -206,22 +221,16 @@ bool Application::internalMainLoop()
     // Trigger RunLoop subscribers
     runLoopEvent.fire();
 
-    // Free views deletion pool.
-    // A view deletion might inserts other views to deletionPool
-    std::deque<View*> undeletedViews;
-    for (auto view : Application::deletionPool)
+    // Free views deletion pool
+    Application::processDeletionPool();
+
+    if (Application::inputReplay)
     {
-        if (!view->isPtrLocked())
-        {
-            delete view;
-        }
-        else
-        {
-            undeletedViews.push_back(view);
-            brls::Logger::verbose("Application: will delete view: {}", view->describe());
-        }
+        Application::inputReplay->addFrameTime(getCPUTimeUsec() - frameStartTime, Application::lastFrameStats);
+
+        if (Application::inputReplay->isFinished())
+            Application::finishInputReplay();
     }
-    Application::deletionPool = undeletedViews;
 
     if (Application::limitedFrameTime > 0)
     {
@@ -250,21 +259,76 @@ void Application::updateFPS()
     }
 }
 
+void Application::processDeletionPool()
+{
+    // Only handle the views that were in the pool when the frame ended,
+    // the ones added by a deletion (Box children) wait for the next frame
+    size_t count = Application::deletionPool.size();
+    Time start   = getCPUTimeUsec();
+
+    // The wall clock budget would make replays delete views on different frames
+    Time budget = Application::inputReplay ? 0 : Application::deletionBudget;
+
+    Application::lastFrameDeletionCount = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // Always delete at least one view per frame
+        if (budget > 0 && Application::lastFrameDeletionCount > 0 && getCPUTimeUsec() - start > budget)
+            break;
+
+        View* view = Application::deletionPool.front();
+        Application::deletionPool.pop_front();
+
+        if (view->isPtrLocked())
+        {
+            Application::deletionPool.push_back(view);
+            brls::Logger::verbose("Application: will delete view: {}", view->describe());
+            continue;
+        }
+
+        delete view;
+        Application::lastFrameDeletionCount++;
+    }
+}
+
 void Application::processInput()
 {
     static ControllerState oldControllerState = {};
 
     // Input
     static ControllerState controllerState = {};
-    std::vector<RawTouchState> rawTouch;
     RawMouseState rawMouse;
 
+    // Touch buffers are reused from one frame to another to avoid
+    // allocating every frame, platforms only push_back into them
+    if (rawTouchState.capacity() < TOUCH_STATES_RESERVE)
+    {
+        rawTouchState.reserve(TOUCH_STATES_RESERVE);
+        nextTouchState.reserve(TOUCH_STATES_RESERVE);
+        currentTouchState.reserve(TOUCH_STATES_RESERVE);
+        queuedTouches.reserve(TOUCH_STATES_RESERVE);
+    }
+    rawTouchState.clear();
+    nextTouchState.clear();
+    queuedTouches.clear();
+
     InputManager* inputManager = Application::platform->getInputManager();
+    if (Application::inputReplay)
+    {
+        // The platform input is ignored while replaying
+        inputManager->getEventQueue()->clear();
+        inputManager = Application::inputReplay;
+    }
+
     inputManager->runloopStart();
-    inputManager->updateTouchStates(&rawTouch);
+    inputManager->updateTouchStates(&rawTouchState);
     inputManager->updateMouseStates(&rawMouse);
     inputManager->updateUnifiedControllerState(&controllerState);
 
+    if (Application::inputRecorder.isRecording())
+        Application::inputRecorder.beginFrame(controllerState, rawTouchState, rawMouse);
+
     if (isSwapInputKeys())
     {
         bool swapKeys[ControllerButton::_BUTTON_MAX];
@@ -275,71 +339,127 @@ void Application::processInput()
             controllerState.buttons[i] = swapKeys[i];
     }
 
-    std::vector<TouchState> touchState;
-    for (auto& i : rawTouch)
+    // Events queued since the last frame are dispatched one by one in order, so that
+    // presses released before being polled or repeated within a frame are not lost.
+    // Buttons and fingers that have events are set by them, the polled state is
+    // only the reference for the others.
+    InputEventQueue* eventQueue = inputManager->getEventQueue();
+    if (size_t dropped = eventQueue->takeDroppedCount())
+        Logger::warning("Input event queue is full, dropped {} events", dropped);
+
+    InputEvent event;
+    while (eventQueue->pop(&event))
     {
-        auto old = std::find_if(std::begin(currentTouchState), std::end(currentTouchState), [rawTouch, &i](TouchState touch)
+        if (Application::inputRecorder.isRecording())
+            Application::inputRecorder.recordEvent(event);
+
+        switch (event.type)
+        {
+            case InputEventType::BUTTON_DOWN:
+            case InputEventType::BUTTON_UP:
+            {
+                ControllerButton button = isSwapInputKeys() ? InputManager::mapControllerState(event.button) : event.button;
+                bool pressed            = event.type == InputEventType::BUTTON_DOWN;
+
+                Application::processButtonEvent(button, pressed, &controllerState, &oldControllerState);
+
+                // The d-pad also navigates, like in the polled state
+                ControllerButton nav = InputManager::getNavigationButton(button);
+                if (nav != _BUTTON_MAX)
+                    Application::processButtonEvent(nav, pressed, &controllerState, &oldControllerState);
+                break;
+            }
+            case InputEventType::TOUCH:
+            {
+                auto current = std::find_if(std::begin(currentTouchState), std::end(currentTouchState), [&event](const TouchState& touch)
+                    { return touch.fingerId == event.touch.fingerId; });
+
+                TouchState last;
+                last.fingerId = event.touch.fingerId;
+                if (current != std::end(currentTouchState))
+                    last = *current;
+
+                TouchState state = InputManager::computeTouchState(event.touch, last);
+                state.timestamp  = event.timestamp;
+
+                if (state.phase != TouchPhase::NONE)
+                    Application::dispatchTouchState(&state);
+
+                if (current != std::end(currentTouchState))
+                    *current = state;
+                else
+                    currentTouchState.push_back(state);
+
+                if (std::find(std::begin(queuedTouches), std::end(queuedTouches), state.fingerId) == std::end(queuedTouches))
+                    queuedTouches.push_back(state.fingerId);
+                break;
+            }
+        }
+    }
+
+    if (Application::inputRecorder.isRecording())
+        Application::inputRecorder.endFrame();
+
+    auto isQueuedTouch = [](int fingerId)
+    { return std::find(std::begin(queuedTouches), std::end(queuedTouches), fingerId) != std::end(queuedTouches); };
+
+    for (const RawTouchState& i : rawTouchState)
+    {
+        // Already dispatched from the queued events
+        if (isQueuedTouch(i.fingerId))
+            continue;
+
+        auto old = std::find_if(std::begin(currentTouchState), std::end(currentTouchState), [&i](const TouchState& touch)
             { return touch.fingerId == i.fingerId; });
 
         if (old != std::end(currentTouchState))
         {
-            touchState.push_back(InputManager::computeTouchState(i, *old));
+            nextTouchState.push_back(InputManager::computeTouchState(i, *old));
         }
         else
         {
             TouchState state;
             state.fingerId = i.fingerId;
-            touchState.push_back(InputManager::computeTouchState(i, state));
+            nextTouchState.push_back(InputManager::computeTouchState(i, state));
         }
     }
 
-    for (auto& i : currentTouchState)
+    for (const TouchState& i : currentTouchState)
     {
         if (i.phase == TouchPhase::NONE)
             continue;
 
-        auto old = std::find_if(std::begin(rawTouch), std::end(rawTouch), [&i](RawTouchState touch)
+        // Keep the state set by the queued events for this frame
+        if (isQueuedTouch(i.fingerId))
+        {
+            nextTouchState.push_back(i);
+            continue;
+        }
+
+        auto old = std::find_if(std::begin(rawTouchState), std::end(rawTouchState), [&i](const RawTouchState& touch)
             { return touch.fingerId == i.fingerId; });
 
-        if (old == std::end(rawTouch))
+        if (old == std::end(rawTouchState))
         {
-            touchState.push_back(InputManager::computeTouchState(RawTouchState(), i));
+            nextTouchState.push_back(InputManager::computeTouchState(RawTouchState(), i));
         }
     }
 
-    for (auto& i : touchState)
+    for (auto& i : nextTouchState)
     {
+        if (isQueuedTouch(i.fingerId))
+            continue;
+
         if (i.phase == TouchPhase::NONE)
         {
             i.view = nullptr;
             break;
         }
-        else if (!i.view || i.phase == TouchPhase::START)
-        {
-            Point position = i.position;
-            Application::setInputType(InputType::TOUCH);
-            Application::setDrawCoursor(false);
-
-            // Search for first responder, which will be the root of recognition tree
-            if (!Application::activitiesStack.empty())
-                i.view = Application::activitiesStack[Application::activitiesStack.size() - 1]
-                             ->getContentView()
-                             ->hitTest(position);
-        }
 
-        if (i.view && i.phase != TouchPhase::NONE)
-        {
-            Sound sound = i.view->gestureRecognizerRequest(i, MouseState(), i.view);
-            float pitch = 1;
-            if (sound == SOUND_TOUCH)
-            {
-                // Play touch sound with random pitch
-                pitch = (rand() % 10) / 10.0f + 1.0f;
-            }
-            Application::getAudioPlayer()->play(sound, pitch);
-        }
+        Application::dispatchTouchState(&i);
     }
-    currentTouchState = touchState;
+    // Swap instead of copying, the old buffer is cleared and refilled next frame
+    currentTouchState.swap(nextTouchState);
 
     MouseState mouseState = InputManager::computeMouseState(rawMouse, currentMouseState);
 
@@ -376,20 +496,21 @@ void Application::processInput()
     }
 
     // Trigger controller events
-    bool repeating                  = false;
-    Time cpuTime = getCPUTimeUsec();
+    // Repeats follow the frame clock, so that they happen on the same frames when replaying
+    bool repeating = false;
+    Time now       = FrameClock::getFrameTime();
 
     for (int i = 0; i < _BUTTON_MAX; i++)
     {
         if (controllerState.buttons[i])
         {
-            repeating = controllerState.repeatingButtonStop[i] > 0 && cpuTime > controllerState.repeatingButtonStop[i];
+            repeating = controllerState.repeatingButtonStop[i] > 0 && now > controllerState.repeatingButtonStop[i];
 
             if (repeating)
-                controllerState.repeatingButtonStop[i] = cpuTime + BUTTON_REPEAT_DELAY;
+                controllerState.repeatingButtonStop[i] = now + BUTTON_REPEAT_DELAY;
 
             if (!oldControllerState.buttons[i])
-                controllerState.repeatingButtonStop[i] = cpuTime + BUTTOM_REPEAT_TRIGGER;
+                controllerState.repeatingButtonStop[i] = now + BUTTOM_REPEAT_TRIGGER;
 
             if (!oldControllerState.buttons[i] || repeating)
                 Application::onControllerButtonPressed((enum ControllerButton)i, repeating);
@@ -401,6 +522,53 @@ void Application::processInput()
     oldControllerState = controllerState;
 }
 
+void Application::processButtonEvent(ControllerButton button, bool pressed, ControllerState* state, ControllerState* oldState)
+{
+    if (pressed && !oldState->buttons[button])
+    {
+        // Armed from the frame clock like the repeats, the event timestamp follows the
+        // input backend clock which drifts from a fixed step or replayed clock
+        state->repeatingButtonStop[button] = FrameClock::getFrameTime() + BUTTOM_REPEAT_TRIGGER;
+        Application::onControllerButtonPressed(button, false);
+    }
+    else if (!pressed)
+    {
+        state->repeatingButtonStop[button] = 0;
+    }
+
+    // The event is newer than the polled state, it becomes the state of this frame
+    state->buttons[button]    = pressed;
+    oldState->buttons[button] = pressed;
+}
+
+void Application::dispatchTouchState(TouchState* touch)
+{
+    if (!touch->view || touch->phase == TouchPhase::START)
+    {
+        Point position = touch->position;
+        Application::setInputType(InputType::TOUCH);
+        Application::setDrawCoursor(false);
+
+        // Search for first responder, which will be the root of recognition tree
+        if (!Application::activitiesStack.empty())
+            touch->view = Application::activitiesStack[Application::activitiesStack.size() - 1]
+                              ->getContentView()
+                              ->hitTest(position);
+    }
+
+    if (touch->view && touch->phase != TouchPhase::NONE)
+    {
+        Sound sound = touch->view->gestureRecognizerRequest(*touch, MouseState(), touch->view);
+        float pitch = 1;
+        if (sound == SOUND_TOUCH)
+        {
+            // Play touch sound with random pitch
+            pitch = (rand() % 10) / 10.0f + 1.0f;
+        }
+        Application::getAudioPlayer()->play(sound, pitch);
+    }
+}
+
 Platform* Application::getPlatform()
 {
     return Application::platform;
@@ -523,6 +691,9 @@ bool Application::setInputType(InputType type)
     Application::inputType = type;
     globalInputTypeChangeEvent.fire(type);
 
+    // Highlights and touch shadows are drawn differently
+    Application::damageAll();
+
     if (type == InputType::GAMEPAD)
     {
         Application::setDrawCoursor(false);
@@ -606,19 +777,19 @@ bool Application::handleAction(char button, bool repeating)
         return false;
 
     View* hintParent = Application::currentFocus;
-    std::set<enum ControllerButton> consumedButtons;
+    std::bitset<_BUTTON_MAX> consumedButtons;
 
     if (!hintParent)
         hintParent = Application::activitiesStack[Application::activitiesStack.size() - 1]->getContentView();
 
     while (hintParent)
     {
-        for (auto& action : hintParent->getActions())
+        for (const Action& action : hintParent->getActions())
         {
             if (action.button != static_cast<enum ControllerButton>(button))
                 continue;
 
-            if (consumedButtons.find(action.button) != consumedButtons.end())
+            if (consumedButtons.test(action.button))
                 continue;
 
             if (action.available && (!repeating || action.allowRepeating))
@@ -631,7 +802,7 @@ bool Application::handleAction(char button, bool repeating)
 
                     Application::getAudioPlayer()->play(action.sound);
 
-                    consumedButtons.insert(action.button);
+                    consumedButtons.set(action.button);
                 }
             }
         }
@@ -639,7 +810,7 @@ bool Application::handleAction(char button, bool repeating)
         hintParent = hintParent->getParent();
     }
 
-    return !consumedButtons.empty();
+    return consumedButtons.any();
 }
 
 void Application::frame()
@@ -654,47 +825,132 @@ void Application::frame()
     frameContext.fontStash  = &Application::fontStash;
     frameContext.theme      = Application::getTheme();
 
-    // Begin frame and clear
+    // Begin frame
     videoContext->beginFrame();
-    videoContext->clear(backgroundColor);
     float scaleFactor = videoContext->getScaleFactor();
 
-    nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, scaleFactor);
-    nvgScale(frameContext.vg, Application::windowScale, Application::windowScale);
+    // With partial redraw, the activities are drawn in the screen framebuffer,
+    // only where they have been damaged since the previous frame
+    VideoFramebuffer* screen = Application::prepareScreenFramebuffer(videoContext);
+    Rect damage;
+
+    // Outdated layers are rendered before anything is drawn in the window,
+    // then drawn like the up to date ones
+    Application::renderPendingLayers(&frameContext);
+
+    if (screen)
+    {
+        damage = Application::fullDamage ? Rect(0, 0, Application::windowWidth / Application::windowScale, Application::windowHeight / Application::windowScale) : Application::damagedRect;
 
-    std::vector<View*> viewsToDraw;
+        // Damage reported while drawing is repainted by the next frame
+        Application::fullDamage  = false;
+        Application::damagedRect = Rect();
+    }
+    else
+    {
+        videoContext->clear(backgroundColor);
+    }
 
-    // Draw all activities in the stack
-    // until we find one that's not translucent
-    for (size_t i = 0; i < Application::activitiesStack.size(); i++)
+    if (!screen || Application::snapDamage(&damage, scaleFactor))
     {
-        Activity* activity = Application::activitiesStack[Application::activitiesStack.size() - 1 - i];
+        if (screen)
+            videoContext->bindFramebuffer(screen);
 
-        View* view = activity->getContentView();
-        if (view)
-            viewsToDraw.push_back(view);
+        nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, scaleFactor);
+        nvgScale(frameContext.vg, Application::windowScale, Application::windowScale);
 
-        if (!activity->isTranslucent())
-            break;
+        if (screen)
+        {
+            // Clear the damaged area only, the rest of the framebuffer is kept
+            nvgScissor(frameContext.vg, damage.getMinX(), damage.getMinY(), damage.getWidth(), damage.getHeight());
+
+            nvgSave(frameContext.vg);
+            nvgGlobalCompositeOperation(frameContext.vg, NVG_COPY);
+            nvgShapeAntiAlias(frameContext.vg, 0);
+            nvgBeginPath(frameContext.vg);
+            nvgRect(frameContext.vg, damage.getMinX(), damage.getMinY(), damage.getWidth(), damage.getHeight());
+            nvgFillColor(frameContext.vg, backgroundColor);
+            nvgFill(frameContext.vg);
+            nvgRestore(frameContext.vg);
+
+            Application::repaintedRect = damage;
+            Application::repainting    = true;
+
+            if (Application::repaintFlashEnabled)
+                Application::repaintFlashes.emplace_back(damage, FrameClock::getFrameTime());
+        }
+
+        // Draw all activities in the stack, starting
+        // from the topmost one that's not translucent
+        size_t firstActivity = Application::activitiesStack.size();
+        while (firstActivity > 0 && Application::activitiesStack[firstActivity - 1]->isTranslucent())
+            firstActivity--;
+
+        if (firstActivity > 0)
+            firstActivity--;
+
+        for (size_t i = firstActivity; i < Application::activitiesStack.size(); i++)
+        {
+            View* view = Application::activitiesStack[i]->getContentView();
+            if (view)
+                view->frame(&frameContext);
+        }
+
+        if (!screen)
+            Application::frameOverlays(&frameContext);
+
+        // End frame
+        nvgResetTransform(Application::getNVGContext()); // scale
+        nvgEndFrame(Application::getNVGContext());
+
+        Application::repainting = false;
+
+        if (screen)
+            videoContext->bindFramebuffer(nullptr);
     }
 
-    for (size_t i = 0; i < viewsToDraw.size(); i++)
+    // Present the screen framebuffer, with the overlays that change every frame on top
+    if (screen)
     {
-        View* view = viewsToDraw[viewsToDraw.size() - 1 - i];
-        view->frame(&frameContext);
+        videoContext->clear(backgroundColor);
+
+        nvgBeginFrame(frameContext.vg, Application::windowWidth, Application::windowHeight, scaleFactor);
+
+        NVGpaint paint = nvgImagePattern(frameContext.vg, 0, 0, screen->width / scaleFactor, screen->height / scaleFactor, 0, screen->image, 1.0f);
+        nvgBeginPath(frameContext.vg);
+        nvgRect(frameContext.vg, 0, 0, screen->width / scaleFactor, screen->height / scaleFactor);
+        nvgFillPaint(frameContext.vg, paint);
+        nvgFill(frameContext.vg);
+
+        nvgScale(frameContext.vg, Application::windowScale, Application::windowScale);
+        Application::frameOverlays(&frameContext);
+
+        nvgResetTransform(Application::getNVGContext()); // scale
+        nvgEndFrame(Application::getNVGContext());
     }
 
+    // Every draw call has been flushed, unused nine-patches can be deleted
+    NinePatchCache::endFrame(frameContext.vg);
+
+    Application::lastFrameStats = Application::platform->getVideoContext()->getFrameStats();
+
+    Application::platform->getVideoContext()->endFrame();
+    FrameClock::endFrame();
+}
+
+void Application::frameOverlays(FrameContext* frameContext)
+{
     if (currentFocus && Application::getInputType() != InputType::TOUCH)
     {
-        currentFocus->frameHighlight(&frameContext);
+        currentFocus->frameHighlight(frameContext);
     }
 
     // Notifications
-    Application::notificationManager->frame(&frameContext);
+    Application::notificationManager->frame(frameContext);
 
     if (isDrawCursor())
     {
-        getPlatform()->getInputManager()->drawCursor(frameContext.vg);
+        getPlatform()->getInputManager()->drawCursor(frameContext->vg);
     }
 
     if (debuggingViewEnabled)
@@ -702,14 +958,183 @@ void Application::frame()
         if (!debugLayer)
             debugLayer = new DebugLayer();
 
-        debugLayer->frame(&frameContext);
+        debugLayer->frame(frameContext);
     }
 
-    // End frame
-    nvgResetTransform(Application::getNVGContext()); // scale
-    nvgEndFrame(Application::getNVGContext());
+    if (!Application::repaintFlashes.empty())
+        Application::drawRepaintFlashes(frameContext->vg);
+}
 
-    Application::platform->getVideoContext()->endFrame();
+void Application::renderPendingLayers(FrameContext* frameContext)
+{
+    // Layers queued while rendering are rendered by the next frame
+    std::swap(Application::pendingLayers, Application::renderingLayers);
+
+    auto depth = [](View* view) {
+        size_t depth = 0;
+        for (View* parent = view->getParent(); parent; parent = parent->getParent())
+            depth++;
+        return depth;
+    };
+
+    // Nested layers first, so that their parent layer draws them up to date
+    std::sort(Application::renderingLayers.begin(), Application::renderingLayers.end(), [&depth](View* a, View* b) {
+        return depth(a) > depth(b);
+    });
+
+    for (size_t i = 0; i < Application::renderingLayers.size(); i++)
+    {
+        View* view = Application::renderingLayers[i];
+
+        // Queued more than once, or since hidden
+        if (!view || view->layerRenderFrame == FrameClock::getFrameCount() || !view->isLayerCached())
+            continue;
+
+        bool visible = true;
+        for (View* parent = view; parent && visible; parent = parent->getParent())
+            visible = parent->getVisibility() == Visibility::VISIBLE;
+
+        if (visible)
+            view->renderLayer(frameContext);
+    }
+
+    Application::renderingLayers.clear();
+}
+
+VideoFramebuffer* Application::prepareScreenFramebuffer(VideoContext* videoContext)
+{
+    if (!Application::partialRedrawEnabled)
+        return nullptr;
+
+    float scaleFactor = videoContext->getScaleFactor();
+    int width         = (int)ceilf(Application::windowWidth * scaleFactor);
+    int height        = (int)ceilf(Application::windowHeight * scaleFactor);
+
+    if (width <= 0 || height <= 0)
+        return nullptr;
+
+    if (Application::screenFramebuffer && (Application::screenFramebuffer->width != width || Application::screenFramebuffer->height != height))
+    {
+        videoContext->deleteFramebuffer(Application::screenFramebuffer);
+        Application::screenFramebuffer = nullptr;
+    }
+
+    if (!Application::screenFramebuffer)
+    {
+        Application::screenFramebuffer = videoContext->createFramebuffer(width, height);
+
+        if (!Application::screenFramebuffer)
+        {
+            Logger::warning("Partial redraw is not supported by the video context, drawing every frame entirely");
+            Application::partialRedrawEnabled = false;
+            return nullptr;
+        }
+
+        Application::fullDamage = true;
+    }
+
+    // Every view depends on the theme
+    if (Application::getThemeVariant() != Application::damageThemeVariant)
+    {
+        Application::damageThemeVariant = Application::getThemeVariant();
+        Application::fullDamage         = true;
+    }
+
+    return Application::screenFramebuffer;
+}
+
+bool Application::snapDamage(Rect* damage, float scaleFactor)
+{
+    // Align the damage on whole pixels so that no pixel is cleared without being drawn again
+    float scale = Application::windowScale * scaleFactor;
+
+    float minX = std::max(floorf(damage->getMinX() * scale), 0.0f);
+    float minY = std::max(floorf(damage->getMinY() * scale), 0.0f);
+    float maxX = std::min(ceilf(damage->getMaxX() * scale), (float)Application::screenFramebuffer->width);
+    float maxY = std::min(ceilf(damage->getMaxY() * scale), (float)Application::screenFramebuffer->height);
+
+    if (maxX <= minX || maxY <= minY)
+        return false;
+
+    *damage = Rect(minX / scale, minY / scale, (maxX - minX) / scale, (maxY - minY) / scale);
+    return true;
+}
+
+void Application::drawRepaintFlashes(NVGcontext* vg)
+{
+    Time now = FrameClock::getFrameTime();
+
+    for (auto it = Application::repaintFlashes.begin(); it != Application::repaintFlashes.end();)
+    {
+        float progress = (float)(now - it->second) / REPAINT_FLASH_DURATION;
+
+        if (progress >= 1.0f)
+        {
+            it = Application::repaintFlashes.erase(it);
+            continue;
+        }
+
+        Rect rect = it->first;
+
+        nvgBeginPath(vg);
+        nvgRect(vg, rect.getMinX(), rect.getMinY(), rect.getWidth(), rect.getHeight());
+        nvgFillColor(vg, nvgRGBAf(1.0f, 0.0f, 1.0f, 0.25f * (1.0f - progress)));
+        nvgFill(vg);
+        nvgStrokeColor(vg, nvgRGBAf(1.0f, 0.0f, 1.0f, 1.0f - progress));
+        nvgStrokeWidth(vg, 2.0f);
+        nvgStroke(vg);
+
+        ++it;
+    }
+}
+
+void Application::setPartialRedrawEnabled(bool enabled)
+{
+    if (Application::partialRedrawEnabled == enabled)
+        return;
+
+    Application::partialRedrawEnabled = enabled;
+    Application::damageAll();
+
+    if (!enabled && Application::screenFramebuffer)
+    {
+        Application::platform->getVideoContext()->deleteFramebuffer(Application::screenFramebuffer);
+        Application::screenFramebuffer = nullptr;
+    }
+}
+
+bool Application::isPartialRedrawEnabled()
+{
+    return Application::partialRedrawEnabled;
+}
+
+void Application::setRepaintFlashEnabled(bool enabled)
+{
+    Application::repaintFlashEnabled = enabled;
+
+    if (!enabled)
+        Application::repaintFlashes.clear();
+}
+
+void Application::addDamage(Rect rect)
+{
+    if (Application::partialRedrawEnabled)
+        Application::damagedRect = Application::damagedRect.unionWith(rect);
+}
+
+void Application::damageAll()
+{
+    Application::fullDamage = true;
+}
+
+void Application::resetScissor(NVGcontext* vg)
+{
+    nvgResetScissor(vg);
+
+    // Never draw outside of the cleared area while partially redrawing
+    if (Application::repainting)
+        nvgScissor(vg, Application::repaintedRect.getMinX(), Application::repaintedRect.getMinY(),
+            Application::repaintedRect.getWidth(), Application::repaintedRect.getHeight());
 }
 
 void Application::exit()
@@ -718,16 +1143,24 @@ void Application::exit()
     exitEvent.fire();
     Logger::info("Exiting...");
 
+    Application::inputRecorder.stop();
+
     Application::clear();
 
     // Free views deletion pool
-    for (auto view : Application::deletionPool)
+    // Deleting a view can add its children to the pool
+    while (!Application::deletionPool.empty())
+    {
+        View* view = Application::deletionPool.front();
+        Application::deletionPool.pop_front();
         delete view;
-
-    Application::deletionPool.clear();
+    }
 
     Threading::stop();
 
+    NinePatchCache::clear(Application::getNVGContext());
+    Application::setPartialRedrawEnabled(false);
+
     exitDoneEvent.fire();
 
     delete Application::notificationManager;
@@ -763,6 +1196,97 @@ size_t Application::getFPS()
     return Application::globalFPS;
 }
 
+VideoFrameStats Application::getFrameStats()
+{
+    return Application::lastFrameStats;
+}
+
+void Application::enqueueLayerRender(View* view)
+{
+    Application::pendingLayers.push_back(view);
+}
+
+void Application::cancelLayerRender(View* view)
+{
+    Application::pendingLayers.erase(std::remove(Application::pendingLayers.begin(), Application::pendingLayers.end(), view), Application::pendingLayers.end());
+
+    // Views deleted while the layers render are skipped
+    std::replace(Application::renderingLayers.begin(), Application::renderingLayers.end(), view, (View*)nullptr);
+}
+
+VideoFramebuffer* Application::acquireLayerFramebuffer(int width, int height)
+{
+    for (size_t i = 0; i < Application::layerFramebuffers.size(); i++)
+    {
+        VideoFramebuffer* framebuffer = Application::layerFramebuffers[i];
+
+        if (framebuffer->width == width && framebuffer->height == height)
+        {
+            Application::layerFramebuffers.erase(Application::layerFramebuffers.begin() + i);
+            return framebuffer;
+        }
+    }
+
+    return Application::platform->getVideoContext()->createFramebuffer(width, height);
+}
+
+void Application::releaseLayerFramebuffer(VideoFramebuffer* framebuffer)
+{
+    VideoContext* videoContext = Application::platform->getVideoContext();
+    float scaleFactor          = videoContext->getScaleFactor();
+
+    // Activity layers can be a pixel off the window height, which is rounded to the content height
+    bool windowSized = framebuffer->width == (int)ceilf(Application::windowWidth * scaleFactor)
+        && abs(framebuffer->height - (int)ceilf(Application::windowHeight * scaleFactor)) <= 1;
+
+    if (windowSized && Application::layerFramebuffers.size() < LAYER_FRAMEBUFFERS_KEPT)
+        Application::layerFramebuffers.push_back(framebuffer);
+    else
+        videoContext->deleteFramebuffer(framebuffer);
+}
+
+bool Application::startInputRecording(const std::string& path)
+{
+    return Application::inputRecorder.start(path);
+}
+
+void Application::stopInputRecording()
+{
+    Application::inputRecorder.stop();
+}
+
+bool Application::startInputReplay(const std::string& path, Time fixedStep)
+{
+    ReplayInputManager* replay = new ReplayInputManager(Application::platform->getInputManager());
+    if (!replay->load(path))
+    {
+        delete replay;
+        return false;
+    }
+
+    delete Application::inputReplay;
+    Application::inputReplay = replay;
+    FrameClock::setFixedStep(fixedStep);
+    return true;
+}
+
+bool Application::isReplayingInput()
+{
+    return Application::inputReplay != nullptr;
+}
+
+void Application::finishInputReplay()
+{
+    FrameTimeReport report = Application::inputReplay->getReport();
+    Logger::info("Input replay finished: {}", report.describe());
+
+    delete Application::inputReplay;
+    Application::inputReplay = nullptr;
+    FrameClock::setFixedStep(0);
+
+    Application::inputReplayFinishedEvent.fire(report);
+}
+
 void Application::setLimitedFPS(size_t fps)
 {
     Application::limitedFrameTime = fps == 0 ? 0 : 1000000.0f / fps;
@@ -775,6 +1299,13 @@ void Application::notify(const std::string& text)
 
 void Application::giveFocus(View* view)
 {
+    // The focused view is being deleted, it cannot be notified anymore
+    if (!view)
+    {
+        Application::currentFocus = nullptr;
+        return;
+    }
+
     View* oldFocus = Application::currentFocus;
     View* newFocus = view ? view->getDefaultFocus() : nullptr;
 
@@ -802,10 +1333,22 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
         return false;
 
     Application::blockInputs();
+    Application::damageAll();
 
     Activity* last = Application::activitiesStack[Application::activitiesStack.size() - 1];
     last->willDisappear(true);
 
+    // Popped before its content was presented: release the inputs blocked by pushActivity
+    for (auto it = Application::constructingActivities.begin(); it != Application::constructingActivities.end(); ++it)
+    {
+        if (it->first == last)
+        {
+            Application::constructingActivities.erase(it);
+            Application::unblockInputs();
+            break;
+        }
+    }
+
     last->setInFadeAnimation(true);
 
     bool fade = animation == TransitionAnimation::FADE;
@@ -838,9 +1381,17 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
         Application::focusStack.pop_back();
     }
 
+    // Animate snapshots of both activities instead of drawing their whole tree every frame
+    last->freezeContent();
+    if (toShow)
+        toShow->freezeContent();
+
     // Hide animation (and show previous activity, if any)
-    last->hide([last, cb, free]()
+    last->hide([last, toShow, cb, free]()
         {
+        last->unfreezeContent();
+        Application::unfreezeActivity(toShow);
+
         // last is not always the top of the stack, for example, during the animation, another activity is pushed
         for (auto i = activitiesStack.begin(); i != activitiesStack.end(); ++i) {
             if ( *i == last ) {
@@ -848,6 +1399,8 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
                 break;
             }
         }
+        Application::damageAll();
+
         cb();
         brls::Logger::debug("Start delete top activity");
         if(free) delete last;
@@ -875,9 +1428,8 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
         Application::focusStack.push_back(Application::currentFocus);
     }
 
-    // Create the activity content view
-    activity->setContentView(activity->createContentView());
-    activity->onContentAvailable();
+    // Create the activity content view, or its placeholder
+    activity->beginConstruction();
     activity->resizeToFitWindow();
 
     if (!Application::activitiesStack.empty())
@@ -886,11 +1438,55 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
         last->onPause();
     }
 
+    // Show the placeholder right away, inputs stay blocked until the content is presented
+    if (activity->isConstructing())
+    {
+        // The placeholder fades in, the content gets the requested transition once ready
+        if (animation == TransitionAnimation::FADE || animation == TransitionAnimation::SLIDE_LEFT || animation == TransitionAnimation::SLIDE_RIGHT)
+        {
+            activity->hide([]() {}, false, 0);
+            activity->show([]() {}, true, activity->getShowAnimationDuration(TransitionAnimation::FADE));
+        }
+
+        activity->willAppear(true);
+        Application::activitiesStack.push_back(activity);
+        Application::constructingActivities.emplace_back(activity, animation);
+        Application::damageAll();
+        return;
+    }
+
+    Application::presentActivity(activity, animation);
+}
+
+void Application::continueActivitiesConstruction()
+{
+    for (size_t i = 0; i < Application::constructingActivities.size();)
+    {
+        auto [activity, animation] = Application::constructingActivities[i];
+
+        if (!activity->continueConstruction())
+        {
+            i++;
+            continue;
+        }
+
+        Application::constructingActivities.erase(Application::constructingActivities.begin() + i);
+        Application::presentActivity(activity, animation);
+    }
+}
+
+void Application::presentActivity(Activity* activity, TransitionAnimation animation)
+{
+    // Already on the stack if it was showing a placeholder
+    bool pushed = std::find(Application::activitiesStack.begin(), Application::activitiesStack.end(), activity) != Application::activitiesStack.end();
+
     bool fadeIn = animation == TransitionAnimation::FADE || animation == TransitionAnimation::SLIDE_LEFT || animation == TransitionAnimation::SLIDE_RIGHT; // wait for the old activity animation to be done before showing the new one?
 
     if (Application::globalQuitEnabled)
         Application::gloablQuitIdentifier = activity->registerExitAction();
 
+    Application::damageAll();
+
     // Layout and prepare activity
     activity->willAppear(true);
     Application::giveFocus(activity->getDefaultFocus());
@@ -898,7 +1494,8 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
     if (!fadeIn) // No animations
     {
         brls::Logger::debug("push activity to the stack");
-        Application::activitiesStack.push_back(activity);
+        if (!pushed)
+            Application::activitiesStack.push_back(activity);
         Application::unblockInputs();
     }
     else
@@ -906,16 +1503,37 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
         activity->hide([]() {}, false, 0);
 
         brls::Logger::debug("push activity to the stack");
-        Application::activitiesStack.push_back(activity);
+        if (!pushed)
+            Application::activitiesStack.push_back(activity);
+
+        // Animate snapshots of both activities instead of drawing their whole tree every frame
+        Activity* previous = Application::activitiesStack.size() > 1 ? Application::activitiesStack[Application::activitiesStack.size() - 2] : nullptr;
+        activity->freezeContent();
+        if (previous)
+            previous->freezeContent();
+
         float duration = activity->getShowAnimationDuration(animation);
-        activity->show([]()
-            { Application::unblockInputs(); },
+        activity->show([activity, previous]()
+            {
+                Application::unfreezeActivity(activity);
+                Application::unfreezeActivity(previous);
+                Application::damageAll();
+                Application::unblockInputs(); },
             duration > 0, duration);
     }
 }
 
+void Application::unfreezeActivity(Activity* activity)
+{
+    // The activity may have been removed from the stack during the transition
+    if (activity && std::find(Application::activitiesStack.begin(), Application::activitiesStack.end(), activity) != Application::activitiesStack.end())
+        activity->unfreezeContent();
+}
+
 void Application::clear()
 {
+    Application::constructingActivities.clear();
+
     for (Activity* activity : Application::activitiesStack)
     {
         activity->willDisappear(true);
@@ -950,14 +1568,35 @@ std::string Application::getLocale()
 
 void Application::addToFreeQueue(View* view)
 {
-    if (std::binary_search(deletionPool.cbegin(), deletionPool.cend(), view))
+    if (view->pendingDelete)
         return;
 
     brls::Logger::verbose("Application::addToFreeQueue {}", view->describe());
 
+    view->pendingDelete = true;
     Application::deletionPool.push_back(view);
 }
 
+void Application::setDeletionBudget(Time budget)
+{
+    Application::deletionBudget = budget;
+}
+
+Time Application::getDeletionBudget()
+{
+    return Application::deletionBudget;
+}
+
+size_t Application::getPendingDeletionCount()
+{
+    return Application::deletionPool.size();
+}
+
+size_t Application::getLastFrameDeletionCount()
+{
+    return Application::lastFrameDeletionCount;
+}
+
 void Application::tryDeinitFirstResponder(View* view)
 {
     if (!view)
@@ -1008,6 +1647,19 @@ bool Application::loadFontFromMemory(std::string fontName, void* address, size_t
     return true;
 }
 
+bool Application::loadFontFromMemory(std::string fontName, const ByteBuffer& data)
+{
+    if (data.empty())
+        return false;
+
+    // The font stash reads the glyphs from the buffer until it is destroyed
+    if (!Application::loadFontFromMemory(fontName, (void*)data.data(), data.size(), false))
+        return false;
+
+    Application::fontBuffers.push_back(data);
+    return true;
+}
+
 void Application::crash(std::string text)
 {
     // To be implemented
@@ -1068,6 +1720,12 @@ void Application::setWindowSize(int width, int height)
     Application::contentWidth  = ORIGINAL_WINDOW_WIDTH;
     Application::contentHeight = (unsigned)roundf((float)height / Application::windowScale);
 
+    // The kept layer framebuffers no longer match the window
+    for (VideoFramebuffer* framebuffer : Application::layerFramebuffers)
+        Application::platform->getVideoContext()->deleteFramebuffer(framebuffer);
+
+    Application::layerFramebuffers.clear();
+
     for (Activity* activity : Application::activitiesStack)
         activity->onWindowSizeChanged();
 
@@ -1199,10 +1857,12 @@ void Application::registerBuiltInXMLViews()
     Application::registerXMLView("brls:TabFrame", TabFrame::create);
     Application::registerXMLView("brls:Sidebar", Sidebar::create);
     Application::registerXMLView("brls:Header", Header::create);
+    Application::registerXMLView("brls:ScrollView", ScrollView::create);
     Application::registerXMLView("brls:ScrollingFrame", ScrollingFrame::create);
     Application::registerXMLView("brls:HScrollingFrame", HScrollingFrame::create);
     Application::registerXMLView("brls:RecyclerFrame", RecyclerFrame::create);
     Application::registerXMLView("brls:Image", Image::create);
+    Application::registerXMLView("brls:AnimatedImage", AnimatedImage::create);
     Application::registerXMLView("brls:Padding", Padding::create);
     Application::registerXMLView("brls:Button", Button::create);
     Application::registerXMLView("brls:CheckBox", CheckBox::create);
@@ -0,0 +1,231 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <yoga/event/event.h>
+
+#include <borealis/core/arena.hpp>
+#include <iterator>
+#include <new>
+
+namespace brls
+{
+
+static constexpr size_t ARENA_ALIGNMENT = alignof(std::max_align_t);
+
+static size_t alignSize(size_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+ViewArena::ViewArena(size_t chunkSize)
+    : chunkSize(alignSize(chunkSize))
+{
+}
+
+ViewArena::~ViewArena()
+{
+    // Only deleted once all the chunks have been freed
+}
+
+char* ViewArena::allocateChunk(size_t size)
+{
+    char* chunk = static_cast<char*>(::operator new(size));
+
+    std::lock_guard<std::mutex> lock(chunksMutex);
+    chunks.emplace(chunk, Chunk { this, size });
+    this->chunkCount++;
+    this->stats.bytesReserved += size;
+
+    return chunk;
+}
+
+void ViewArena::freeChunk(ChunkMap::iterator chunk)
+{
+    if (chunk->first + chunk->second.size == this->chunkEnd)
+        this->chunkCursor = this->chunkEnd = nullptr;
+
+    this->stats.bytesReserved -= chunk->second.size;
+    this->chunkCount--;
+
+    ::operator delete(const_cast<char*>(chunk->first));
+    chunks.erase(chunk);
+}
+
+ViewArena::ChunkMap::iterator ViewArena::findChunk(const void* ptr)
+{
+    const char* address = static_cast<const char*>(ptr);
+
+    // The chunk starting right before the address, if it contains it
+    auto it = chunks.upper_bound(address);
+    if (it == chunks.begin())
+        return chunks.end();
+
+    --it;
+    return address < it->first + it->second.size ? it : chunks.end();
+}
+
+void* ViewArena::allocateBlock(size_t size)
+{
+    // Reuse a freed block of the same size first
+    auto it = this->freeLists.find(size);
+    if (it != this->freeLists.end() && it->second)
+    {
+        FreeBlock* block = it->second;
+        it->second       = block->next;
+        return block;
+    }
+
+    // Blocks bigger than a chunk get a dedicated one
+    if (size > this->chunkSize)
+        return this->allocateChunk(size);
+
+    if (!this->chunkCursor || this->chunkCursor + size > this->chunkEnd)
+    {
+        this->chunkCursor = this->allocateChunk(this->chunkSize);
+        this->chunkEnd    = this->chunkCursor + this->chunkSize;
+    }
+
+    void* block = this->chunkCursor;
+    this->chunkCursor += size;
+    return block;
+}
+
+void* ViewArena::allocate(size_t size)
+{
+    size_t blockSize = alignSize(sizeof(BlockHeader) + size);
+
+    BlockHeader* header = static_cast<BlockHeader*>(this->allocateBlock(blockSize));
+    header->size        = blockSize;
+
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex);
+        findChunk(header)->second.liveBlocks++;
+    }
+
+    this->stats.liveObjects++;
+    this->stats.bytesAllocated += blockSize;
+    this->stats.bytesInUse += blockSize;
+    if (this->stats.bytesInUse > this->stats.peakBytesInUse)
+        this->stats.peakBytesInUse = this->stats.bytesInUse;
+
+    return header + 1;
+}
+
+void ViewArena::freeBlock(BlockHeader* header, ChunkMap::iterator chunk)
+{
+    size_t size = header->size;
+
+    this->stats.bytesInUse -= size;
+    this->stats.liveObjects--;
+    chunk->second.liveBlocks--;
+
+    if (!this->released)
+    {
+        FreeBlock* block      = reinterpret_cast<FreeBlock*>(header);
+        block->next           = this->freeLists[size];
+        this->freeLists[size] = block;
+        return;
+    }
+
+    // Nothing is allocated anymore once released, the last block frees the chunk
+    if (chunk->second.liveBlocks == 0)
+        this->freeChunk(chunk);
+
+    if (this->chunkCount == 0)
+        delete this;
+}
+
+void* ViewArena::allocateInCurrent(size_t size)
+{
+    if (current)
+        return current->allocate(size);
+
+    // A zero size marks the block as a heap one
+    BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+    header->size        = 0;
+    return header + 1;
+}
+
+void ViewArena::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    // Heap blocks never take the lock
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    if (header->size == 0)
+    {
+        ::operator delete(header);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(chunksMutex);
+
+    auto chunk = findChunk(header);
+    chunk->second.arena->freeBlock(header, chunk);
+}
+
+YGNodeRef ViewArena::createNode()
+{
+    void* memory   = this->allocate(sizeof(YGNode));
+    YGNodeRef node = new (memory) YGNode { YGConfigGetDefault() };
+    facebook::yoga::Event::publish<facebook::yoga::Event::NodeAllocation>(node, { node->getConfig() });
+
+    return node;
+}
+
+void ViewArena::freeNode(YGNodeRef node)
+{
+    if (YGNodeRef owner = node->getOwner())
+    {
+        owner->removeChild(node);
+        node->setOwner(nullptr);
+    }
+
+    for (YGNodeRef child : node->getChildren())
+        child->setOwner(nullptr);
+
+    node->clearChildren();
+
+    facebook::yoga::Event::publish<facebook::yoga::Event::NodeDeallocation>(node, { node->getConfig() });
+    node->~YGNode();
+
+    ViewArena::deallocate(node);
+}
+
+void ViewArena::release()
+{
+    this->released = true;
+    this->freeLists.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex);
+
+        // Free the empty chunks now, the others are freed with their last block
+        for (auto it = chunks.begin(); it != chunks.end();)
+        {
+            auto next = std::next(it);
+            if (it->second.arena == this && it->second.liveBlocks == 0)
+                this->freeChunk(it);
+            it = next;
+        }
+    }
+
+    if (this->chunkCount == 0)
+        delete this;
+}
+
+} // namespace brls
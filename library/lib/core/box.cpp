@@ -452,6 +452,12 @@ void Box::willDisappear(bool resetState)
         child->willDisappear(resetState);
 }
 
+void Box::willBecomeVisible()
+{
+    for (View* child : this->children)
+        child->willBecomeVisible();
+}
+
 void Box::onWindowSizeChanged()
 {
     for (View* child : this->children)
@@ -744,10 +750,14 @@ View* Padding::create()
 
 Box::~Box()
 {
+    // With a deletion budget, children are deleted over the next frames
+    // instead of in cascade
+    bool deferred = Application::getDeletionBudget() > 0;
+
     for (auto it : getChildren())
     {
         it->setParent(nullptr);
-        if (!it->isPtrLocked())
+        if (!it->isPtrLocked() && !deferred)
         {
             delete it;
         }
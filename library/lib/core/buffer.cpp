@@ -0,0 +1,119 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/buffer.hpp>
+#include <borealis/core/logger.hpp>
+#include <cstdio>
+#include <cstring>
+
+#ifdef USE_LIBROMFS
+#include <romfs/romfs.hpp>
+#endif
+
+namespace brls
+{
+
+ByteBuffer ByteBuffer::fromString(std::string&& data)
+{
+    auto string = std::make_shared<std::string>(std::move(data));
+
+    ByteBuffer buffer;
+    buffer.bytes  = (const uint8_t*)string->data();
+    buffer.length = string->size();
+    buffer.owner  = std::move(string);
+    return buffer;
+}
+
+ByteBuffer ByteBuffer::fromVector(std::vector<uint8_t>&& data)
+{
+    auto vector = std::make_shared<std::vector<uint8_t>>(std::move(data));
+
+    ByteBuffer buffer;
+    buffer.bytes  = vector->data();
+    buffer.length = vector->size();
+    buffer.owner  = std::move(vector);
+    return buffer;
+}
+
+ByteBuffer ByteBuffer::copy(const void* data, size_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    if (size > 0)
+        memcpy(bytes.data(), data, size);
+
+    return ByteBuffer::fromVector(std::move(bytes));
+}
+
+ByteBuffer ByteBuffer::wrap(const void* data, size_t size, Deleter deleter)
+{
+    ByteBuffer buffer;
+    buffer.bytes  = (const uint8_t*)data;
+    buffer.length = size;
+    buffer.owner  = std::shared_ptr<const void>(data, [deleter, size](const void* data)
+         { deleter((const uint8_t*)data, size); });
+    return buffer;
+}
+
+ByteBuffer ByteBuffer::view(const void* data, size_t size)
+{
+    ByteBuffer buffer;
+    buffer.bytes  = (const uint8_t*)data;
+    buffer.length = size;
+    return buffer;
+}
+
+ByteBuffer ByteBuffer::fromFile(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        Logger::error("Cannot open {}", path);
+        return ByteBuffer();
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    std::vector<uint8_t> bytes(size > 0 ? size : 0);
+    size_t read = bytes.empty() ? 0 : fread(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+
+    if (read != bytes.size())
+    {
+        Logger::error("Cannot read {}", path);
+        return ByteBuffer();
+    }
+
+    return ByteBuffer::fromVector(std::move(bytes));
+}
+
+ByteBuffer ByteBuffer::fromRes(const std::string& name)
+{
+#ifdef USE_LIBROMFS
+    // The romfs is part of the executable, no need to own it
+    const romfs::Resource* resource = romfs::find(name);
+    if (resource && resource->valid())
+        return ByteBuffer::view(resource->data(), resource->size());
+
+    Logger::error("Cannot find resource {}", name);
+    return ByteBuffer();
+#else
+    return ByteBuffer::fromFile(std::string(BRLS_RESOURCES) + name);
+#endif
+}
+
+} // namespace brls
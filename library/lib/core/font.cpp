@@ -48,12 +48,7 @@ bool FontLoader::loadFontFromFile(std::string fontName, std::string filePath)
 bool FontLoader::loadMaterialFromResources()
 {
 #ifdef USE_LIBROMFS
-    auto& font = romfs::get(MATERIAL_ICONS);
-    if (!font.valid())
-    {
-        return false;
-    }
-    return Application::loadFontFromMemory(FONT_MATERIAL_ICONS, (void*)font.data(), font.size(), false);
+    return Application::loadFontFromMemory(FONT_MATERIAL_ICONS, ByteBuffer::fromRes(MATERIAL_ICONS));
 #else
     return this->loadFontFromFile(FONT_MATERIAL_ICONS, MATERIAL_ICONS_PATH);
 #endif
@@ -14,6 +14,7 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <borealis/core/geometry.hpp>
 
 namespace brls
@@ -176,4 +177,20 @@ Rect Rect::offsetBy(const Point& origin) const
     return Rect(this->origin + origin, this->size);
 }
 
+Rect Rect::unionWith(const Rect& other) const
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return other;
+
+    if (other.getWidth() <= 0 || other.getHeight() <= 0)
+        return *this;
+
+    float minX = std::min(getMinX(), other.getMinX());
+    float minY = std::min(getMinY(), other.getMinY());
+    float maxX = std::max(getMaxX(), other.getMaxX());
+    float maxY = std::max(getMaxY(), other.getMaxY());
+
+    return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
 } // namespace brls
@@ -24,24 +24,276 @@ namespace fs = boost::filesystem;
 #include <filesystem>
 namespace fs = std::filesystem;
 #endif
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 
 #ifndef BRLS_I18N_PREFIX
 #define BRLS_I18N_PREFIX ""
 #endif
 
+// Binary catalog layout: magic, version, entries count, then for each
+// entry the key length, key, value length and value. Integers are 32 bits
+// little endian.
+#define CATALOG_MAGIC "BRLSI18N"
+#define CATALOG_MAGIC_SIZE 8
+#define CATALOG_VERSION 1
+
 namespace brls
 {
 
-static nlohmann::json defaultLocale = {};
-static nlohmann::json currentLocale = {};
+// All the translations flattened to "file/key/subkey" -> string, the current
+// locale overriding the default one. Views point into catalogStorage, or into
+// the romfs for the catalogs bundled with the application.
+static std::unordered_map<std::string_view, internal::TranslatedString> catalog;
+static std::deque<std::string> catalogStorage;
+static std::deque<internal::FormatString> formatStorage;
+
+static std::string_view intern(std::string str)
+{
+    catalogStorage.push_back(std::move(str));
+    return catalogStorage.back();
+}
+
+static bool parseFormatString(std::string_view text, internal::FormatString* format)
+{
+    size_t literalStart = 0;
+    int autoIndex       = 0;
+    bool manualIndex    = false;
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (text[i] == '}')
+        {
+            // Escaped brace, keep one
+            if (i + 1 >= text.size() || text[i + 1] != '}')
+                return false;
+
+            format->segments.push_back({ text.substr(literalStart, i + 1 - literalStart), "" });
+            literalStart = ++i + 1;
+            continue;
+        }
+
+        if (text[i] != '{')
+            continue;
+
+        if (i + 1 < text.size() && text[i + 1] == '{')
+        {
+            format->segments.push_back({ text.substr(literalStart, i + 1 - literalStart), "" });
+            literalStart = ++i + 1;
+            continue;
+        }
+
+        size_t end = text.find_first_of("{}", i + 1);
+        if (end == std::string_view::npos || text[end] != '}')
+            return false;
+
+        std::string_view field = text.substr(i + 1, end - i - 1);
+        size_t colon           = field.find(':');
+        std::string_view id    = field.substr(0, colon);
+        std::string_view spec  = colon == std::string_view::npos ? std::string_view() : field.substr(colon);
+
+        int index;
+        if (id.empty())
+        {
+            if (manualIndex)
+                return false;
+            index = autoIndex++;
+        }
+        else if (id.find_first_not_of("0123456789") == std::string_view::npos)
+        {
+            if (autoIndex > 0)
+                return false;
+            manualIndex = true;
+
+            // Out of range indices are rejected like any other invalid placeholder
+            auto [ptr, ec] = std::from_chars(id.data(), id.data() + id.size(), index);
+            if (ec != std::errc() || ptr != id.data() + id.size())
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+
+        format->segments.push_back({ text.substr(literalStart, i - literalStart), "{" + std::to_string(index) + std::string(spec) + "}", index, spec.empty() });
+        literalStart = end + 1;
+        i            = end;
+    }
+
+    if (literalStart < text.size())
+        format->segments.push_back({ text.substr(literalStart), "" });
+
+    return true;
+}
+
+static internal::TranslatedString makeTranslatedString(std::string_view text)
+{
+    internal::TranslatedString str;
+    str.text = text;
+
+    if (text.find_first_of("{}") == std::string_view::npos)
+        return str;
+
+    internal::FormatString& format = formatStorage.emplace_back();
+    if (!parseFormatString(text, &format))
+    {
+        format.segments.clear();
+        format.runtime = true;
+    }
+
+    str.format = &format;
+    return str;
+}
+
+static void addString(const std::string& key, std::string value)
+{
+    auto it = catalog.find(key);
+
+    if (it != catalog.end())
+        it->second = makeTranslatedString(intern(std::move(value)));
+    else
+        catalog.emplace(intern(key), makeTranslatedString(intern(std::move(value))));
+}
+
+static void flattenStrings(const nlohmann::json& node, std::string& path)
+{
+    size_t length = path.length();
+
+    if (node.is_string())
+    {
+        addString(path, node.get<std::string>());
+    }
+    else if (node.is_object())
+    {
+        for (auto& item : node.items())
+        {
+            path += "/";
+            path += item.key();
+            flattenStrings(item.value(), path);
+            path.resize(length);
+        }
+    }
+    else if (node.is_array())
+    {
+        for (size_t i = 0; i < node.size(); i++)
+        {
+            path += "/";
+            path += std::to_string(i);
+            flattenStrings(node[i], path);
+            path.resize(length);
+        }
+    }
+}
+
+static void loadStrings(const std::string& name, const nlohmann::json& strings)
+{
+    std::string path = name;
+    flattenStrings(strings, path);
+}
+
+static uint32_t readUInt32(const char* data)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void writeUInt32(std::ostream& stream, uint32_t value)
+{
+    char bytes[4] = {
+        (char)(value & 0xFF),
+        (char)((value >> 8) & 0xFF),
+        (char)((value >> 16) & 0xFF),
+        (char)((value >> 24) & 0xFF),
+    };
+    stream.write(bytes, 4);
+}
+
+// The blob must outlive the catalog
+static bool loadCatalog(const std::string& path, std::string_view blob)
+{
+    if (blob.size() < CATALOG_MAGIC_SIZE + 8 || blob.substr(0, CATALOG_MAGIC_SIZE) != CATALOG_MAGIC || readUInt32(blob.data() + CATALOG_MAGIC_SIZE) != CATALOG_VERSION)
+    {
+        Logger::error("Cannot load translations catalog \"{}\": invalid header", path);
+        return false;
+    }
+
+    uint32_t count = readUInt32(blob.data() + CATALOG_MAGIC_SIZE + 4);
+    size_t offset  = CATALOG_MAGIC_SIZE + 8;
+
+    catalog.reserve(catalog.size() + count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        std::string_view entry[2];
+
+        for (std::string_view& field : entry)
+        {
+            if (offset + 4 > blob.size())
+            {
+                Logger::error("Cannot load translations catalog \"{}\": truncated file", path);
+                return false;
+            }
+
+            uint32_t length = readUInt32(blob.data() + offset);
+            offset += 4;
+
+            if (offset + length > blob.size())
+            {
+                Logger::error("Cannot load translations catalog \"{}\": truncated file", path);
+                return false;
+            }
+
+            field = blob.substr(offset, length);
+            offset += length;
+        }
+
+        catalog[entry[0]] = makeTranslatedString(entry[1]);
+    }
+
+    return true;
+}
+
+static bool loadLocaleCatalog(const std::string& locale)
+{
+    if (locale.empty())
+        return false;
+#ifdef USE_LIBROMFS
+    // Parsed in place, the romfs is part of the executable
+    std::string catalogPath         = "i18n/" + locale + ".catalog";
+    const romfs::Resource* resource = romfs::find(catalogPath);
+    if (resource)
+        return loadCatalog(catalogPath, std::string_view((const char*)resource->data(), resource->size()));
+#else
+    std::string catalogPath = BRLS_ASSET("i18n/" + locale + ".catalog");
+    if (fs::exists(catalogPath))
+    {
+        std::ifstream catalogStream(catalogPath, std::ios::binary);
+        std::stringstream data;
+        data << catalogStream.rdbuf();
+
+        return loadCatalog(catalogPath, intern(data.str()));
+    }
+#endif /* USE_LIBROMFS */
+    return false;
+}
 
-static void loadLocale(std::string locale, nlohmann::json* target)
+static void loadLocale(std::string locale, bool useCatalog = true)
 {
     if (locale.empty())
         return;
+
+    // Prefer the precompiled catalog if there is one
+    if (useCatalog && loadLocaleCatalog(locale))
+        return;
 #ifdef USE_LIBROMFS
     auto localePath = romfs::list("i18n/" + locale);
     if (localePath.empty())
@@ -56,7 +308,14 @@ static void loadLocale(std::string locale, nlohmann::json* target)
         if (!endsWith(name, ".json"))
             continue;
 
-        (*target)[name.substr(0, name.length() - 5)] = nlohmann::json::parse(romfs::get(path).string());
+        nlohmann::json strings = nlohmann::json::parse(romfs::get(path).string(), nullptr, false);
+        if (strings.is_discarded())
+        {
+            Logger::error("Error while loading \"{}\": invalid JSON", path);
+            continue;
+        }
+
+        loadStrings(name.substr(0, name.length() - 5), strings);
     }
 #else
     std::string localePath = BRLS_ASSET("i18n/" + locale);
@@ -105,56 +364,184 @@ static void loadLocale(std::string locale, nlohmann::json* target)
 
         jsonStream.close();
 
-        (*target)[name.substr(0, name.length() - 5)] = strings;
+        loadStrings(name.substr(0, name.length() - 5), strings);
     }
 #endif /* USE_LIBROMFS */
 }
 
+static void clearTranslations()
+{
+    catalog.clear();
+    catalogStorage.clear();
+    formatStorage.clear();
+}
+
 void loadTranslations()
 {
-    loadLocale(LOCALE_DEFAULT, &defaultLocale);
+    clearTranslations();
 
+    // A precompiled catalog already contains the default strings
     std::string currentLocaleName = Application::getLocale();
+    if (currentLocaleName != LOCALE_DEFAULT && loadLocaleCatalog(currentLocaleName))
+    {
+        Logger::debug("Loaded {} translated strings", catalog.size());
+        return;
+    }
+
+    loadLocale(LOCALE_DEFAULT);
+
+    // Strings of the current locale override the default ones
     if (currentLocaleName != LOCALE_DEFAULT)
-        loadLocale(currentLocaleName, &currentLocale);
+        loadLocale(currentLocaleName);
+
+    Logger::debug("Loaded {} translated strings", catalog.size());
 }
 
-namespace internal
+bool saveTranslationsCatalog(const std::string& path)
 {
-    std::string getRawStr(std::string stringName)
+    std::vector<std::pair<std::string_view, std::string_view>> entries;
+    entries.reserve(catalog.size());
+    for (auto& entry : catalog)
+        entries.emplace_back(entry.first, entry.second.text);
+
+    std::sort(entries.begin(), entries.end());
+
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
     {
-        nlohmann::json::json_pointer pointer;
+        Logger::error("Cannot write translations catalog \"{}\"", path);
+        return false;
+    }
 
-        try
-        {
-            pointer = nlohmann::json::json_pointer("/" + std::string(BRLS_I18N_PREFIX) + stringName);
-        }
-        catch (const std::exception& e)
-        {
-            Logger::error("Error while getting string \"{}\": {}", stringName, e.what());
-            return stringName;
-        }
+    stream.write(CATALOG_MAGIC, CATALOG_MAGIC_SIZE);
+    writeUInt32(stream, CATALOG_VERSION);
+    writeUInt32(stream, (uint32_t)entries.size());
 
-        // First look for translated string in current locale
-        try
+    for (auto& entry : entries)
+    {
+        writeUInt32(stream, (uint32_t)entry.first.size());
+        stream.write(entry.first.data(), entry.first.size());
+        writeUInt32(stream, (uint32_t)entry.second.size());
+        stream.write(entry.second.data(), entry.second.size());
+    }
+
+    return stream.good();
+}
+
+bool compileTranslationsCatalog(const std::string& locale, const std::string& path)
+{
+    clearTranslations();
+
+    // Always from the JSON files, an existing catalog may be outdated
+    loadLocale(LOCALE_DEFAULT, false);
+
+    if (locale != LOCALE_DEFAULT)
+        loadLocale(locale, false);
+
+    Logger::debug("Compiled {} translated strings", catalog.size());
+
+    return saveTranslationsCatalog(path);
+}
+
+namespace internal
+{
+    TranslatedString findStr(std::string_view stringName)
+    {
+        if (sizeof(BRLS_I18N_PREFIX) == 1)
         {
-            return currentLocale[pointer].get<std::string>();
+            auto it = catalog.find(stringName);
+            return it != catalog.end() ? it->second : TranslatedString();
         }
-        catch (...)
+
+        thread_local std::string key;
+        key.assign(BRLS_I18N_PREFIX);
+        key.append(stringName);
+
+        auto it = catalog.find(key);
+        return it != catalog.end() ? it->second : TranslatedString();
+    }
+
+    std::string_view findRawStr(std::string_view stringName)
+    {
+        return findStr(stringName).text;
+    }
+
+    // Appends integers and strings directly, returns false for
+    // the other types so that they go through fmt
+    struct PlainArgAppender
+    {
+        std::string& buffer;
+
+        template <typename T>
+        bool operator()(T value)
         {
+            if constexpr (std::is_same_v<T, const char*>)
+            {
+                buffer.append(value);
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, fmt::string_view>)
+            {
+                buffer.append(value.data(), value.size());
+                return true;
+            }
+            else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> && sizeof(T) <= sizeof(long long))
+            {
+                // fmt::format_int has no 128-bit constructor, those go through fmt
+                fmt::format_int formatted(value);
+                buffer.append(formatted.data(), formatted.size());
+                return true;
+            }
+            else
+            {
+                return false;
+            }
         }
+    };
 
-        // Then look for default locale
-        try
+    static bool appendPlainArg(std::string& buffer, const fmt::format_args& args, int index)
+    {
+        fmt::basic_format_arg<fmt::format_context> arg = args.get(index);
+        if (!arg)
+            return false;
+
+#if FMT_VERSION >= 110000
+        return arg.visit(PlainArgAppender { buffer });
+#else
+        return fmt::visit_format_arg(PlainArgAppender { buffer }, arg);
+#endif
+    }
+
+    void vformatTo(std::string& buffer, const TranslatedString& str, fmt::format_args args)
+    {
+        auto out = std::back_inserter(buffer);
+
+        if (str.format->runtime)
         {
-            return defaultLocale[pointer].get<std::string>();
+            fmt::vformat_to(out, fmt::string_view(str.text.data(), str.text.size()), args);
+            return;
         }
-        catch (...)
+
+        for (const FormatString::Segment& segment : str.format->segments)
         {
+            buffer.append(segment.literal);
+
+            if (segment.field.empty() || (segment.plain && appendPlainArg(buffer, args, segment.argIndex)))
+                continue;
+
+            fmt::vformat_to(out, segment.field, args);
         }
+    }
+
+    std::string getRawStr(std::string stringName)
+    {
+        std::string_view str = findRawStr(stringName);
 
         // Fallback to returning the string name
-        return stringName;
+        if (str.data() == nullptr)
+            return stringName;
+
+        return std::string(str);
     }
 } // namespace internal
 
@@ -40,12 +40,101 @@ TouchPhase getPhase(TouchPhase oldState, bool newState)
     return getPhase(old, newState);
 }
 
+InputEventQueue::InputEventQueue()
+{
+    for (size_t i = 0; i < CAPACITY; i++)
+        this->cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool InputEventQueue::push(const InputEvent& event)
+{
+    size_t position = this->pushPosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell      = this->cells[position % CAPACITY];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff   = (intptr_t)sequence - (intptr_t)position;
+
+        if (diff == 0)
+        {
+            // The cell is free, try to claim it
+            if (this->pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.event = event;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The cell has not been popped yet, the queue is full
+            this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = this->pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool InputEventQueue::pop(InputEvent* event)
+{
+    size_t position = this->popPosition.load(std::memory_order_relaxed);
+    Cell& cell      = this->cells[position % CAPACITY];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+    // Nothing has been pushed in this cell yet
+    if (sequence != position + 1)
+        return false;
+
+    *event = cell.event;
+    this->popPosition.store(position + 1, std::memory_order_relaxed);
+    cell.sequence.store(position + CAPACITY, std::memory_order_release);
+    return true;
+}
+
+void InputEventQueue::clear()
+{
+    InputEvent event;
+    while (this->pop(&event))
+        ;
+}
+
+size_t InputEventQueue::takeDroppedCount()
+{
+    return this->droppedCount.exchange(0, std::memory_order_relaxed);
+}
+
+void InputManager::pushButtonEvent(ControllerButton button, bool pressed, Time timestamp)
+{
+    InputEvent event;
+    event.type      = pressed ? InputEventType::BUTTON_DOWN : InputEventType::BUTTON_UP;
+    event.timestamp = timestamp != 0 ? timestamp : getCPUTimeUsec();
+    event.button    = button;
+
+    // Called from any thread: drops are logged by the main thread
+    this->eventQueue.push(event);
+}
+
+void InputManager::pushTouchEvent(RawTouchState touch, Time timestamp)
+{
+    InputEvent event;
+    event.type      = InputEventType::TOUCH;
+    event.timestamp = timestamp != 0 ? timestamp : getCPUTimeUsec();
+    event.touch     = touch;
+
+    this->eventQueue.push(event);
+}
+
 TouchState InputManager::computeTouchState(RawTouchState currentTouch, TouchState lastFrameState)
 {
     TouchState state;
     state.fingerId = lastFrameState.fingerId;
     state.view     = lastFrameState.view;
-    state.phase    = getPhase(lastFrameState.phase, currentTouch.pressed);
+    state.phase     = getPhase(lastFrameState.phase, currentTouch.pressed);
+    state.timestamp = FrameClock::getFrameTime();
     if (state.phase == TouchPhase::END)
         state.position = lastFrameState.position;
     else
@@ -86,4 +175,21 @@ ControllerButton InputManager::mapControllerState(ControllerButton button)
     }
 }
 
+ControllerButton InputManager::getNavigationButton(ControllerButton button)
+{
+    switch (button)
+    {
+        case BUTTON_UP:
+            return BUTTON_NAV_UP;
+        case BUTTON_RIGHT:
+            return BUTTON_NAV_RIGHT;
+        case BUTTON_DOWN:
+            return BUTTON_NAV_DOWN;
+        case BUTTON_LEFT:
+            return BUTTON_NAV_LEFT;
+        default:
+            return _BUTTON_MAX;
+    }
+}
+
 } // namespace brls
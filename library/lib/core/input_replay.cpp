@@ -0,0 +1,413 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <borealis/core/input_replay.hpp>
+#include <borealis/core/logger.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace brls
+{
+
+// File layout, in native endianness:
+//  header: "BRLSINPT", uint32 version
+//  then for every frame:
+//   uint32 buttons bitmask, float axes[_AXES_MAX]
+//   float mouse position, offset and scroll (x, y), uint8 mouse buttons bitmask
+//   uint8 touches count, then for every touch: int32 finger id, float x, float y
+//   uint8 events count, then for every event: uint8 type, uint8 button, uint8 pressed, int32 finger id, float x, float y,
+//   int32 timestamp relative to the frame time, in microseconds (since version 2)
+static const char REPLAY_MAGIC[8]      = { 'B', 'R', 'L', 'S', 'I', 'N', 'P', 'T' };
+static const uint32_t REPLAY_VERSION   = 2;
+static const size_t REPLAY_MAX_ENTRIES = 255;
+
+static_assert(_BUTTON_MAX <= 32, "buttons must fit in the replay bitmask");
+
+template <typename T>
+static void writeValue(FILE* file, T value)
+{
+    fwrite(&value, sizeof(T), 1, file);
+}
+
+template <typename T>
+static bool readValue(FILE* file, T* value)
+{
+    return fread(value, sizeof(T), 1, file) == 1;
+}
+
+static void writeTouch(FILE* file, const RawTouchState& touch)
+{
+    writeValue<int32_t>(file, touch.fingerId);
+    writeValue<float>(file, touch.position.x);
+    writeValue<float>(file, touch.position.y);
+}
+
+static bool readTouch(FILE* file, RawTouchState* touch)
+{
+    int32_t fingerId;
+    float x, y;
+    if (!readValue(file, &fingerId) || !readValue(file, &x) || !readValue(file, &y))
+        return false;
+
+    touch->fingerId = fingerId;
+    touch->position = Point(x, y);
+    return true;
+}
+
+InputRecorder::~InputRecorder()
+{
+    this->stop();
+}
+
+bool InputRecorder::start(const std::string& path)
+{
+    this->stop();
+
+    this->file = fopen(path.c_str(), "wb");
+    if (!this->file)
+    {
+        Logger::error("Cannot open input recording file {}", path);
+        return false;
+    }
+
+    fwrite(REPLAY_MAGIC, sizeof(REPLAY_MAGIC), 1, this->file);
+    writeValue<uint32_t>(this->file, REPLAY_VERSION);
+
+    Logger::info("Recording input to {}", path);
+    return true;
+}
+
+void InputRecorder::stop()
+{
+    if (!this->file)
+        return;
+
+    fclose(this->file);
+    this->file = nullptr;
+}
+
+void InputRecorder::beginFrame(const ControllerState& controller, const std::vector<RawTouchState>& touches, const RawMouseState& mouse)
+{
+    memcpy(this->frame.buttons, controller.buttons, sizeof(this->frame.buttons));
+    memcpy(this->frame.axes, controller.axes, sizeof(this->frame.axes));
+    this->frame.mouse   = mouse;
+    this->frame.touches = touches;
+    this->frame.events.clear();
+}
+
+void InputRecorder::recordEvent(const InputEvent& event)
+{
+    if (this->frame.events.size() >= REPLAY_MAX_ENTRIES)
+        return;
+
+    // Relative to the frame, so that the replay can rebase it on its own frame clock
+    InputEvent recorded = event;
+    recorded.timestamp  = event.timestamp - FrameClock::getFrameTime();
+    this->frame.events.push_back(recorded);
+}
+
+void InputRecorder::endFrame()
+{
+    if (!this->file)
+        return;
+
+    uint32_t buttons = 0;
+    for (int i = 0; i < _BUTTON_MAX; i++)
+    {
+        if (this->frame.buttons[i])
+            buttons |= 1u << i;
+    }
+
+    writeValue<uint32_t>(this->file, buttons);
+    for (float axis : this->frame.axes)
+        writeValue<float>(this->file, axis);
+
+    const RawMouseState& mouse = this->frame.mouse;
+    for (float value : { mouse.position.x, mouse.position.y, mouse.offset.x, mouse.offset.y, mouse.scroll.x, mouse.scroll.y })
+        writeValue<float>(this->file, value);
+    writeValue<uint8_t>(this->file, (mouse.leftButton ? 1 : 0) | (mouse.middleButton ? 2 : 0) | (mouse.rightButton ? 4 : 0));
+
+    size_t touches = std::min(this->frame.touches.size(), REPLAY_MAX_ENTRIES);
+    writeValue<uint8_t>(this->file, (uint8_t)touches);
+    for (size_t i = 0; i < touches; i++)
+        writeTouch(this->file, this->frame.touches[i]);
+
+    writeValue<uint8_t>(this->file, (uint8_t)this->frame.events.size());
+    for (const InputEvent& event : this->frame.events)
+    {
+        writeValue<uint8_t>(this->file, (uint8_t)event.type);
+        writeValue<uint8_t>(this->file, (uint8_t)event.button);
+        writeValue<uint8_t>(this->file, event.touch.pressed ? 1 : 0);
+        writeTouch(this->file, event.touch);
+        writeValue<int32_t>(this->file, (int32_t)std::clamp<Time>(event.timestamp, INT32_MIN, INT32_MAX));
+    }
+}
+
+ReplayInputManager::ReplayInputManager(InputManager* platformInputManager)
+    : platformInputManager(platformInputManager)
+{
+}
+
+bool ReplayInputManager::load(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        Logger::error("Cannot open input recording file {}", path);
+        return false;
+    }
+
+    char magic[sizeof(REPLAY_MAGIC)];
+    uint32_t version = 0;
+    if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 || !readValue(file, &version) || version < 1 || version > REPLAY_VERSION)
+    {
+        Logger::error("{} is not a supported input recording", path);
+        fclose(file);
+        return false;
+    }
+
+    this->frames.clear();
+    this->currentFrame = 0;
+    this->started      = false;
+    this->frameTimes.clear();
+
+    uint32_t buttons;
+    while (readValue(file, &buttons))
+    {
+        InputFrame frame;
+        bool valid = true;
+
+        for (int i = 0; i < _BUTTON_MAX; i++)
+            frame.buttons[i] = buttons & (1u << i);
+
+        for (float& axis : frame.axes)
+            valid &= readValue(file, &axis);
+
+        float mouse[6];
+        for (float& value : mouse)
+            valid &= readValue(file, &value);
+
+        uint8_t mouseButtons = 0, touches = 0, events = 0;
+        valid &= readValue(file, &mouseButtons);
+
+        frame.mouse.position     = Point(mouse[0], mouse[1]);
+        frame.mouse.offset       = Point(mouse[2], mouse[3]);
+        frame.mouse.scroll       = Point(mouse[4], mouse[5]);
+        frame.mouse.leftButton   = mouseButtons & 1;
+        frame.mouse.middleButton = mouseButtons & 2;
+        frame.mouse.rightButton  = mouseButtons & 4;
+
+        valid &= readValue(file, &touches);
+        for (uint8_t i = 0; valid && i < touches; i++)
+        {
+            RawTouchState touch;
+            touch.pressed = true;
+            valid &= readTouch(file, &touch);
+            frame.touches.push_back(touch);
+        }
+
+        valid &= readValue(file, &events);
+        for (uint8_t i = 0; valid && i < events; i++)
+        {
+            InputEvent event;
+            uint8_t type      = 0, button = 0, pressed = 0;
+            int32_t timestamp = 0;
+            valid &= readValue(file, &type) && readValue(file, &button) && readValue(file, &pressed) && readTouch(file, &event.touch);
+
+            if (version >= 2)
+                valid &= readValue(file, &timestamp);
+
+            event.type          = (InputEventType)type;
+            event.button        = (ControllerButton)button;
+            event.touch.pressed = pressed;
+            event.timestamp     = timestamp;
+            frame.events.push_back(event);
+        }
+
+        if (!valid)
+        {
+            Logger::warning("Input recording {} is truncated, replaying the first {} frames", path, this->frames.size());
+            break;
+        }
+
+        this->frames.push_back(std::move(frame));
+    }
+
+    fclose(file);
+
+    Logger::info("Replaying {} frames of input from {}", this->frames.size(), path);
+    return true;
+}
+
+const InputFrame* ReplayInputManager::getFrame() const
+{
+    if (!this->started || this->isFinished())
+        return nullptr;
+
+    return &this->frames[this->currentFrame];
+}
+
+void ReplayInputManager::runloopStart()
+{
+    this->platformInputManager->runloopStart();
+
+    if (this->started)
+        this->currentFrame++;
+    this->started = true;
+
+    const InputFrame* frame = this->getFrame();
+    if (!frame)
+        return;
+
+    // Recorded relative to the frame, rebased on the fixed step frame clock
+    for (const InputEvent& event : frame->events)
+    {
+        Time timestamp = FrameClock::getFrameTime() + event.timestamp;
+
+        if (event.type == InputEventType::TOUCH)
+            this->pushTouchEvent(event.touch, timestamp);
+        else
+            this->pushButtonEvent(event.button, event.type == InputEventType::BUTTON_DOWN, timestamp);
+    }
+}
+
+void ReplayInputManager::updateUnifiedControllerState(ControllerState* state)
+{
+    this->updateControllerState(state, 0);
+}
+
+void ReplayInputManager::updateControllerState(ControllerState* state, int controller)
+{
+    const InputFrame* frame = this->getFrame();
+
+    for (int i = 0; i < _BUTTON_MAX; i++)
+        state->buttons[i] = frame && controller == 0 ? frame->buttons[i] : false;
+
+    for (int i = 0; i < _AXES_MAX; i++)
+        state->axes[i] = frame && controller == 0 ? frame->axes[i] : 0.0f;
+}
+
+void ReplayInputManager::updateTouchStates(std::vector<RawTouchState>* states)
+{
+    const InputFrame* frame = this->getFrame();
+    if (frame)
+        states->insert(states->end(), frame->touches.begin(), frame->touches.end());
+}
+
+void ReplayInputManager::updateMouseStates(RawMouseState* state)
+{
+    const InputFrame* frame = this->getFrame();
+    *state                  = frame ? frame->mouse : RawMouseState();
+}
+
+short ReplayInputManager::getControllersConnectedCount()
+{
+    return 1;
+}
+
+bool ReplayInputManager::getKeyboardKeyState(BrlsKeyboardScancode)
+{
+    return false;
+}
+
+void ReplayInputManager::sendRumble(unsigned short, unsigned short, unsigned short)
+{
+}
+
+void ReplayInputManager::drawCursor(NVGcontext* vg)
+{
+    this->platformInputManager->drawCursor(vg);
+}
+
+void ReplayInputManager::addFrameTime(Time time, const VideoFrameStats& stats)
+{
+    if (!this->getFrame())
+        return;
+
+    this->frameTimes.push_back(time);
+    this->totalStats.drawCalls += stats.drawCalls;
+    this->totalStats.vertices += stats.vertices;
+    this->totalStats.textureBinds += stats.textureBinds;
+}
+
+FrameTimeReport ReplayInputManager::getReport() const
+{
+    FrameTimeReport report;
+    report.frames = this->frameTimes.size();
+
+    if (report.frames == 0)
+        return report;
+
+    std::vector<Time> sorted = this->frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](float p)
+    {
+        size_t index = std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5f));
+        return sorted[index] / 1000.0f;
+    };
+
+    Time total = 0;
+    for (Time time : sorted)
+        total += time;
+
+    report.average = total / 1000.0f / sorted.size();
+    report.median  = percentile(0.5f);
+    report.p95     = percentile(0.95f);
+    report.p99     = percentile(0.99f);
+    report.max     = sorted.back() / 1000.0f;
+
+    report.drawCalls    = (float)this->totalStats.drawCalls / sorted.size();
+    report.vertices     = (float)this->totalStats.vertices / sorted.size();
+    report.textureBinds = (float)this->totalStats.textureBinds / sorted.size();
+    return report;
+}
+
+std::string FrameTimeReport::describe() const
+{
+    return fmt::format("{} frames, average {:.2f}ms, median {:.2f}ms, p95 {:.2f}ms, p99 {:.2f}ms, max {:.2f}ms, {:.1f} draw calls per frame",
+        this->frames, this->average, this->median, this->p95, this->p99, this->max, this->drawCalls);
+}
+
+std::string FrameTimeReport::toJSON() const
+{
+    nlohmann::json json = {
+        { "frames", this->frames },
+        { "frame_time_ms",
+            {
+                { "average", this->average },
+                { "median", this->median },
+                { "p95", this->p95 },
+                { "p99", this->p99 },
+                { "max", this->max },
+            } },
+        { "per_frame",
+            {
+                { "draw_calls", this->drawCalls },
+                { "vertices", this->vertices },
+                { "texture_binds", this->textureBinds },
+            } },
+    };
+
+    return json.dump(4);
+}
+
+} // namespace brls
@@ -0,0 +1,276 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/nine_patch.hpp>
+#include <cmath>
+#include <vector>
+
+#define MAX_PATCHES 64
+
+// Sizes in the patch keys are rounded to this fraction of a pixel
+#define PATCH_KEY_STEPS 2.0f
+
+namespace brls
+{
+
+// Same signed distance as the nanovg gradient shader
+static float sdRoundRect(float x, float y, float extentX, float extentY, float radius)
+{
+    float dx = fabsf(x) - (extentX - radius);
+    float dy = fabsf(y) - (extentY - radius);
+
+    float outsideX = fmaxf(dx, 0.0f);
+    float outsideY = fmaxf(dy, 0.0f);
+
+    return fminf(fmaxf(dx, dy), 0.0f) + sqrtf(outsideX * outsideX + outsideY * outsideY) - radius;
+}
+
+static float clamp01(float value)
+{
+    return fminf(fmaxf(value, 0.0f), 1.0f);
+}
+
+float NinePatchCache::getPixelScale()
+{
+    return Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
+}
+
+NinePatchCache::PatchKey NinePatchCache::makeKey(PatchType type, float radius, float width, float feather, float offset)
+{
+    // Animated radii and widths would otherwise render a new texture every frame,
+    // the rounding error is too small to be seen
+    float scale = roundf(getPixelScale() * 64.0f) / 64.0f;
+    float steps = fmaxf(scale, 1.0f / 64.0f) * PATCH_KEY_STEPS;
+
+    auto quantize = [steps](float value)
+    { return roundf(value * steps) / steps; };
+
+    return { (float)type, quantize(radius), quantize(width), quantize(feather), quantize(offset), scale };
+}
+
+NinePatchCache::Patch NinePatchCache::renderPatch(NVGcontext* vg, const PatchKey& key)
+{
+    PatchType type = (PatchType)key[0];
+    float radius   = key[1];
+    float width    = key[2]; // stroke width or shadow width
+    float feather  = fmaxf(1.0f, key[3]);
+    float offset   = key[4];
+    float scale    = key[5];
+
+    Patch patch;
+
+    // Distance from the frame edges to where the shape stops changing
+    float innerLeft, innerRight, innerTop, innerBottom;
+
+    switch (type)
+    {
+        case PatchType::FILL:
+            innerLeft = innerRight = innerTop = innerBottom = radius;
+            break;
+        case PatchType::BORDER:
+            innerLeft = innerRight = innerTop = innerBottom = radius;
+
+            patch.extentLeft = patch.extentRight = patch.extentTop = patch.extentBottom = width / 2;
+            break;
+        case PatchType::SHADOW:
+            // The gradient is shifted down by the shadow width and
+            // has twice the corner radius, the hole has the corner radius
+            innerLeft = innerRight = radius * 2;
+            innerTop               = fmaxf(width + radius * 2, radius);
+            innerBottom            = fmaxf(radius * 2 - width, radius);
+
+            patch.extentLeft = patch.extentRight = patch.extentTop = offset;
+            patch.extentBottom                                     = offset * 2;
+            break;
+    }
+
+    patch.left   = (int)ceilf((patch.extentLeft + innerLeft) * scale) + 1;
+    patch.right  = (int)ceilf((patch.extentRight + innerRight) * scale) + 1;
+    patch.top    = (int)ceilf((patch.extentTop + innerTop) * scale) + 1;
+    patch.bottom = (int)ceilf((patch.extentBottom + innerBottom) * scale) + 1;
+
+    int textureWidth  = patch.left + 1 + patch.right;
+    int textureHeight = patch.top + 1 + patch.bottom;
+
+    // Size of the smallest frame the texture can hold
+    float frameWidth  = textureWidth / scale - patch.extentLeft - patch.extentRight;
+    float frameHeight = textureHeight / scale - patch.extentTop - patch.extentBottom;
+
+    // Premultiplied white, the color is applied when drawing
+    std::vector<unsigned char> pixels(textureWidth * textureHeight * 4);
+
+    for (int j = 0; j < textureHeight; j++)
+    {
+        for (int i = 0; i < textureWidth; i++)
+        {
+            // Pixel center, relative to the frame center
+            float x = (i + 0.5f) / scale - patch.extentLeft - frameWidth / 2;
+            float y = (j + 0.5f) / scale - patch.extentTop - frameHeight / 2;
+
+            float coverage = 0.0f;
+
+            switch (type)
+            {
+                case PatchType::FILL:
+                    coverage = clamp01(0.5f - sdRoundRect(x, y, frameWidth / 2, frameHeight / 2, radius) * scale);
+                    break;
+                case PatchType::BORDER:
+                    coverage = clamp01((width / 2 - fabsf(sdRoundRect(x, y, frameWidth / 2, frameHeight / 2, radius))) * scale + 0.5f);
+                    break;
+                case PatchType::SHADOW:
+                {
+                    float gradient = clamp01((sdRoundRect(x, y - width, frameWidth / 2, frameHeight / 2, radius * 2) + feather * 0.5f) / feather);
+                    float hole     = clamp01(sdRoundRect(x, y, frameWidth / 2, frameHeight / 2, radius) * scale + 0.5f);
+
+                    coverage = (1.0f - gradient) * hole;
+                    break;
+                }
+            }
+
+            unsigned char value = (unsigned char)roundf(coverage * 255.0f);
+            unsigned char* pixel = &pixels[(j * textureWidth + i) * 4];
+
+            pixel[0] = pixel[1] = pixel[2] = pixel[3] = value;
+        }
+    }
+
+    patch.image = nvgCreateImageRGBA(vg, textureWidth, textureHeight, NVG_IMAGE_PREMULTIPLIED, pixels.data());
+
+    return patch;
+}
+
+bool NinePatchCache::drawPatch(NVGcontext* vg, PatchKey key, float x, float y, float width, float height, NVGcolor color)
+{
+    if (!enabled)
+        return false;
+
+    // The cache can grow past MAX_PATCHES during the frame: the textures
+    // used by the queued draw calls are only deleted in endFrame()
+    auto it = patches.find(key);
+
+    if (it == patches.end())
+        it = patches.emplace(key, renderPatch(vg, key)).first;
+
+    Patch& patch        = it->second;
+    patch.lastUsedFrame = frameIndex;
+    float scale         = key[5];
+
+    if (patch.image == 0)
+        return false;
+
+    float outerX      = x - patch.extentLeft;
+    float outerY      = y - patch.extentTop;
+    float outerWidth  = width + patch.extentLeft + patch.extentRight;
+    float outerHeight = height + patch.extentTop + patch.extentBottom;
+
+    // Too small, the corners would overlap
+    if ((patch.left + patch.right) / scale > outerWidth || (patch.top + patch.bottom) / scale > outerHeight)
+        return false;
+
+    float textureWidth  = patch.left + 1 + patch.right;
+    float textureHeight = patch.top + 1 + patch.bottom;
+
+    float xs[4] = { outerX, outerX + patch.left / scale, outerX + outerWidth - patch.right / scale, outerX + outerWidth };
+    float ys[4] = { outerY, outerY + patch.top / scale, outerY + outerHeight - patch.bottom / scale, outerY + outerHeight };
+
+    // The center column and row stretch the middle pixel
+    float us[6] = { 0.0f, patch.left / textureWidth, (patch.left + 0.5f) / textureWidth, (patch.left + 0.5f) / textureWidth, (textureWidth - patch.right) / textureWidth, 1.0f };
+    float vs[6] = { 0.0f, patch.top / textureHeight, (patch.top + 0.5f) / textureHeight, (patch.top + 0.5f) / textureHeight, (textureHeight - patch.bottom) / textureHeight, 1.0f };
+
+    float quads[9 * 8];
+    float* quad = quads;
+
+    for (int row = 0; row < 3; row++)
+    {
+        for (int column = 0; column < 3; column++)
+        {
+            quad[0] = xs[column];
+            quad[1] = ys[row];
+            quad[2] = xs[column + 1] - xs[column];
+            quad[3] = ys[row + 1] - ys[row];
+            quad[4] = us[column * 2];
+            quad[5] = vs[row * 2];
+            quad[6] = us[column * 2 + 1];
+            quad[7] = vs[row * 2 + 1];
+
+            quad += 8;
+        }
+    }
+
+    nvgImageQuads(vg, patch.image, color, quads, 9);
+
+    return true;
+}
+
+bool NinePatchCache::drawRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius, NVGcolor color)
+{
+    return drawPatch(vg, makeKey(PatchType::FILL, radius, 0.0f, 0.0f, 0.0f), x, y, width, height, color);
+}
+
+bool NinePatchCache::drawRoundedBorder(NVGcontext* vg, float x, float y, float width, float height, float radius, float strokeWidth, NVGcolor color)
+{
+    return drawPatch(vg, makeKey(PatchType::BORDER, radius, strokeWidth, 0.0f, 0.0f), x, y, width, height, color);
+}
+
+bool NinePatchCache::drawShadow(NVGcontext* vg, float x, float y, float width, float height, float radius,
+    float shadowWidth, float shadowFeather, float shadowOffset, NVGcolor color)
+{
+    return drawPatch(vg, makeKey(PatchType::SHADOW, radius, shadowWidth, shadowFeather, shadowOffset), x, y, width, height, color);
+}
+
+void NinePatchCache::clear(NVGcontext* vg)
+{
+    for (auto& patch : patches)
+    {
+        if (patch.second.image)
+            nvgDeleteImage(vg, patch.second.image);
+    }
+
+    patches.clear();
+}
+
+void NinePatchCache::endFrame(NVGcontext* vg)
+{
+    while (patches.size() > MAX_PATCHES)
+    {
+        auto oldest = patches.begin();
+        for (auto it = patches.begin(); it != patches.end(); ++it)
+        {
+            if (it->second.lastUsedFrame < oldest->second.lastUsedFrame)
+                oldest = it;
+        }
+
+        if (oldest->second.image)
+            nvgDeleteImage(vg, oldest->second.image);
+
+        patches.erase(oldest);
+    }
+
+    frameIndex++;
+}
+
+void NinePatchCache::setEnabled(bool enabled)
+{
+    NinePatchCache::enabled = enabled;
+}
+
+bool NinePatchCache::isEnabled()
+{
+    return NinePatchCache::enabled;
+}
+
+} // namespace brls
@@ -166,14 +166,15 @@ void StyleValues::addMetric(const std::string& name, float metric)
     this->values[name] = metric;
 }
 
-float StyleValues::getMetric(const std::string& name)
+float StyleValues::getMetric(std::string_view name)
 {
-    if (this->values.count(name) == 0) {
+    auto it = this->values.find(name);
+    if (it == this->values.end()) {
         brls::Logger::error("Unknown style metric {} in size: {}", name, std::to_string(this->values.size()));
         return 0;
     }
 
-    return this->values[name];
+    return it->second;
 }
 
 Style::Style(StyleValues* values)
@@ -181,7 +182,7 @@ Style::Style(StyleValues* values)
 {
 }
 
-float Style::getMetric(const std::string& name)
+float Style::getMetric(std::string_view name)
 {
     return this->values->getMetric(name);
 }
@@ -191,7 +192,7 @@ void Style::addMetric(const std::string& name, float metric)
     return this->values->addMetric(name, metric);
 }
 
-float Style::operator[](const std::string& name)
+float Style::operator[](std::string_view name)
 {
     return this->getMetric(name);
 }
@@ -150,12 +150,13 @@ void ThemeValues::addColor(const std::string& name, NVGcolor color)
         this->values[name] = color;
 }
 
-NVGcolor ThemeValues::getColor(const std::string& name)
+NVGcolor ThemeValues::getColor(std::string_view name)
 {
-    if (this->values.count(name) == 0)
-        fatal("Unknown theme value \"" + name + "\" in size: " + std::to_string(this->values.size()));
+    auto it = this->values.find(name);
+    if (it == this->values.end())
+        fatal("Unknown theme value \"" + std::string(name) + "\" in size: " + std::to_string(this->values.size()));
 
-    return this->values[name];
+    return it->second;
 }
 
 Theme::Theme(ThemeValues* values)
@@ -163,7 +164,7 @@ Theme::Theme(ThemeValues* values)
 {
 }
 
-NVGcolor Theme::getColor(const std::string& name)
+NVGcolor Theme::getColor(std::string_view name)
 {
     return this->values->getColor(name);
 }
@@ -173,7 +174,7 @@ void Theme::addColor(const std::string& name, NVGcolor color)
     return this->values->addColor(name, color);
 }
 
-NVGcolor Theme::operator[](const std::string& name)
+NVGcolor Theme::operator[](std::string_view name)
 {
     return this->getColor(name);
 }
@@ -19,30 +19,111 @@
 namespace brls
 {
 
+void FrameClock::beginFrame()
+{
+    Time now = getCPUTimeUsec();
+    Time time;
+
+    if (FrameClock::fixedStep > 0)
+    {
+        time = FrameClock::frameCount == 0 ? now : FrameClock::frameTime + FrameClock::fixedStep;
+    }
+    else if (FrameClock::frameInterval > 0 && FrameClock::lastPresentTime > 0)
+    {
+        // The last frame has been presented on a vsync, this one will be on the next one
+        Time intervals = (now - FrameClock::lastPresentTime) / FrameClock::frameInterval + 1;
+        time           = FrameClock::lastPresentTime + intervals * FrameClock::frameInterval;
+    }
+    else
+    {
+        time = now;
+    }
+
+    // Never go back in time, if the interval changed for instance
+    if (FrameClock::frameCount > 0 && time < FrameClock::frameTime)
+        time = FrameClock::frameTime;
+
+    FrameClock::frameDelta = FrameClock::frameCount == 0 ? 0 : time - FrameClock::frameTime;
+    FrameClock::frameTime  = time;
+    FrameClock::frameCount++;
+}
+
+void FrameClock::endFrame()
+{
+    FrameClock::lastPresentTime = getCPUTimeUsec();
+}
+
+void FrameClock::setFrameInterval(Time interval)
+{
+    FrameClock::frameInterval   = interval > 0 ? interval : 0;
+    FrameClock::lastPresentTime = 0;
+}
+
+void FrameClock::setFixedStep(Time step)
+{
+    FrameClock::fixedStep = step > 0 ? step : 0;
+}
+
 void Ticking::updateTickings()
 {
     // Update time
     static Time previousTime = 0;
 
-    Time currentTime = getCPUTimeUsec() / 1000;
+    Time currentTime = FrameClock::getFrameTime() / 1000;
     Time delta       = previousTime == 0 ? 0 : currentTime - previousTime;
 
     previousTime = currentTime;
 
     // Update every running ticking, kill them and execute cb if they are finished
-    // We have to clone the running tickings list to avoid altering it while
-    // in the for loop (so if another ticking is started in a callback or during onUpdate())
-    std::vector<Ticking*> tickings(Ticking::runningTickings);
+    // Tickings started during the loop (in a callback or during onUpdate()) get a new slot
+    // at the end of the list and will only be updated next frame, stopped tickings
+    // leave their slot empty so indices stay valid until the list is compacted
+    size_t count = Ticking::runningTickings.size();
 
-    for (Ticking* ticking : tickings)
+    for (size_t i = 0; i < count; i++)
     {
+        Ticking* ticking = Ticking::runningTickings[i];
+
+        if (!ticking)
+            continue;
+
         bool run = ticking->onUpdate(delta);
 
         ticking->tickCallback();
 
         if (!run)
-            ticking->stop(true); // will remove the ticking from Ticking::runningTickings
+            ticking->stop(true); // will empty the ticking slot
+    }
+
+    Ticking::compactTickings();
+}
+
+void Ticking::compactTickings()
+{
+    if (Ticking::runningTickingsCount == Ticking::runningTickings.size())
+        return;
+
+    size_t next = 0;
+    for (Ticking* ticking : Ticking::runningTickings)
+    {
+        if (!ticking)
+            continue;
+
+        ticking->slot                    = next;
+        Ticking::runningTickings[next++] = ticking;
     }
+
+    Ticking::runningTickings.resize(next);
+}
+
+size_t Ticking::getRunningTickingsCount()
+{
+    return Ticking::runningTickingsCount;
+}
+
+const std::vector<Ticking*>& Ticking::getRunningTickings()
+{
+    return Ticking::runningTickings;
 }
 
 void Ticking::start()
@@ -50,7 +131,9 @@ void Ticking::start()
     if (this->running)
         return;
 
+    this->slot = Ticking::runningTickings.size();
     Ticking::runningTickings.push_back(this);
+    Ticking::runningTickingsCount++;
 
     this->running = true;
 
@@ -67,14 +150,8 @@ void Ticking::stop(bool finished)
     if (!this->running)
         return;
 
-    for (size_t i = 0; i < Ticking::runningTickings.size(); i++)
-    {
-        if (Ticking::runningTickings[i] == this)
-        {
-            Ticking::runningTickings.erase(Ticking::runningTickings.begin() + i);
-            break;
-        }
-    }
+    Ticking::runningTickings[this->slot] = nullptr;
+    Ticking::runningTickingsCount--;
 
     this->running = false;
 
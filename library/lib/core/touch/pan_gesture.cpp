@@ -44,12 +44,14 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
     TouchPhase phase = touch.phase;
     Point position   = touch.position;
     int fingerId     = touch.fingerId;
+    Time time        = touch.timestamp;
 
     if (phase == TouchPhase::NONE)
     {
         fingerId = 0;
         position = mouse.position;
         phase    = mouse.leftButton;
+        time     = FrameClock::getFrameTime();
     }
 
     // If not first touch frame and state is
@@ -71,6 +73,7 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
     {
         case TouchPhase::START:
             this->posHistory.clear();
+            this->timeHistory.clear();
             this->state         = GestureState::UNSURE;
             this->startPosition = position;
             this->position      = position;
@@ -131,13 +134,15 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
 
             if (this->state == GestureState::END)
             {
-                float time = posHistory.size() * 1.0f / Application::getFPS();
+                float duration = (time - timeHistory.back()) / 1000000.0f;
+                if (duration <= 0.0f)
+                    duration = posHistory.size() * 1.0f / Application::getFPS();
 
                 float distanceX = posHistory[posHistory.size()-1].x - posHistory[0].x;
                 float distanceY = posHistory[posHistory.size()-1].y - posHistory[0].y;
 
-                float velocityX = distanceX / time;
-                float velocityY = distanceY / time;
+                float velocityX = distanceX / duration;
+                float velocityY = distanceY / duration;
                 if (panFactor > 0.0f) {
                     velocityX *= panFactor;
                     velocityY *= panFactor;
@@ -165,9 +170,11 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
 
     // Add current state to history
     posHistory.insert(posHistory.begin(), this->position);
+    timeHistory.insert(timeHistory.begin(), time);
     while (posHistory.size() > HISTORY_LIMIT)
     {
         posHistory.pop_back();
+        timeHistory.pop_back();
     }
 
     lastState = this->state;
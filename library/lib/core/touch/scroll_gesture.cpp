@@ -35,6 +35,16 @@ GestureState ScrollGestureRecognizer::recognitionLoop(TouchState touch, MouseSta
     GestureState result;
     if (mouse.scroll.x != 0 || mouse.scroll.y != 0)
     {
+        // Already handled by a scroll recognizer closer to the cursor
+        for (View* child = mouse.view; child && child != view; child = child->getParent())
+        {
+            for (GestureRecognizer* recognizer : child->getGestureRecognizers())
+            {
+                if (recognizer->isEnabled() && dynamic_cast<ScrollGestureRecognizer*>(recognizer))
+                    return GestureState::FAILED;
+            }
+        }
+
         result = GestureState::STAY;
         PanGestureStatus status {
             .state         = GestureState::STAY,
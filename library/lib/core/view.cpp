@@ -25,6 +25,7 @@
 #include <borealis/core/box.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/nine_patch.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/applet_frame.hpp>
@@ -60,7 +61,8 @@ AppletFrameItem::~AppletFrameItem()
 View::View()
 {
     // Instantiate and prepare YGNode
-    this->ygNode = YGNodeNew();
+    this->arena  = ViewArena::getCurrent();
+    this->ygNode = this->arena ? this->arena->createNode() : YGNodeNew();
     YGNodeSetContext(this->ygNode, this);
 
     YGNodeStyleSetWidthAuto(this->ygNode);
@@ -85,14 +87,19 @@ static int shakeAnimation(float t, float a) // a = amplitude
 
 void View::shakeHighlight(FocusDirection direction)
 {
+    this->invalidateLayer();
+
     this->highlightShaking        = true;
-    this->highlightShakeStart     = getCPUTimeUsec() / 1000;
+    this->highlightShakeStart     = FrameClock::getFrameTime() / 1000;
     this->highlightShakeDirection = direction;
     this->highlightShakeAmplitude = std::rand() % 15 + 10;
 }
 
 float View::getAlpha(bool child)
 {
+    if (this->layerRendering)
+        return 1.0f;
+
     return this->alpha * (this->parent ? this->parent->getAlpha(true) : 1.0f);
 }
 
@@ -154,6 +161,41 @@ void View::frame(FrameContext* ctx)
     if (this->visibility != Visibility::VISIBLE)
         return;
 
+    // Keep the cached layers up to date while animations are running
+    if (this->highlightAlpha.isRunning() || this->clickAlpha.isRunning() || this->collapseState.isRunning() || this->highlightShaking)
+        this->invalidateLayer();
+
+    if (this->alpha.isRunning())
+    {
+        if (this->hasParent())
+            this->getParent()->invalidateLayer();
+        else
+            this->damage();
+    }
+
+    if (this->layerCached)
+    {
+        // A layer rendered for this frame is drawn as is, even if the animations
+        // above invalidated it again: it is rendered once more before the next frame
+        bool fresh = this->layerRenderFrame == FrameClock::getFrameCount();
+
+        if (this->layer && (fresh || !this->layerDirty) && this->isLayerUpToDate())
+        {
+            this->drawnFrame = this->getFrame();
+            this->drawLayer(ctx);
+            return;
+        }
+    }
+
+    this->frameContent(ctx);
+
+    // Outdated layers are drawn directly, and rendered before the next frame
+    if (this->layerCached && this->getAlpha() > 0.0f)
+        Application::enqueueLayerRender(this);
+}
+
+void View::frameContent(FrameContext* ctx)
+{
     Style style    = Application::getStyle();
     Theme oldTheme = ctx->theme;
 
@@ -169,6 +211,8 @@ void View::frame(FrameContext* ctx)
     float width  = frame.getWidth();
     float height = frame.getHeight();
 
+    this->drawnFrame = frame;
+
     if (this->alpha > 0.0f && this->collapseState != 0.0f)
     {
         // Draw background
@@ -217,6 +261,199 @@ void View::frame(FrameContext* ctx)
     nvgRestore(ctx->vg);
 }
 
+void View::setLayerCached(bool cached)
+{
+    if (this->layerCached == cached)
+        return;
+
+    this->layerCached = cached;
+    this->layerDirty  = true;
+
+    if (cached)
+    {
+        Application::enqueueLayerRender(this);
+    }
+    else
+    {
+        Application::cancelLayerRender(this);
+
+        if (this->layer)
+        {
+            Application::releaseLayerFramebuffer(this->layer);
+            this->layer = nullptr;
+        }
+    }
+}
+
+bool View::isLayerCached()
+{
+    return this->layerCached;
+}
+
+void View::freezeLayer()
+{
+    if (this->layerFrozen)
+        return;
+
+    this->layerCachedByUser = this->layerCached;
+    this->setLayerCached(true);
+
+    // Take a fresh snapshot, then ignore invalidations
+    this->layerDirty  = true;
+    this->layerFrozen = true;
+
+    Application::enqueueLayerRender(this);
+}
+
+void View::unfreezeLayer()
+{
+    if (!this->layerFrozen)
+        return;
+
+    this->layerFrozen = false;
+
+    // The content may have changed while frozen
+    this->invalidateLayer();
+
+    if (!this->layerCachedByUser)
+        this->setLayerCached(false);
+}
+
+bool View::isLayerFrozen()
+{
+    return this->layerFrozen;
+}
+
+void View::invalidateLayer()
+{
+    this->damage();
+
+    for (View* view = this; view; view = view->getParent())
+    {
+        // Frozen layers keep their snapshot
+        if (!view->layerCached || view->layerFrozen || view->layerDirty)
+            continue;
+
+        view->layerDirty = true;
+        Application::enqueueLayerRender(view);
+    }
+}
+
+void View::getLayerSize(int* width, int* height)
+{
+    float scale = Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
+
+    *width  = (int)ceilf(this->getWidth() * scale);
+    *height = (int)ceilf(this->getHeight() * scale);
+}
+
+void View::damage()
+{
+    if (!Application::isPartialRedrawEnabled())
+        return;
+
+    this->damageFrame(this->getFrame());
+}
+
+void View::damageFrame(Rect frame)
+{
+    // Also skips the NaN sizes of views that were never laid out
+    if (!(frame.getWidth() > 0) || !(frame.getHeight() > 0))
+        return;
+
+    Style style = Application::getStyle();
+
+    // Highlight background, shadows and shake animation are drawn around the view
+    float margin = this->highlightPadding + style["brls/highlight/stroke_width"]
+        + std::max((float)style["brls/shadow/offset"], (float)style["brls/highlight/shadow_offset"]) * 3;
+
+    if (this->highlightShaking)
+        margin += this->highlightShakeAmplitude;
+
+    Application::addDamage(Rect(frame.getMinX() - margin, frame.getMinY() - margin,
+        frame.getWidth() + margin * 2, frame.getHeight() + margin * 2));
+}
+
+bool View::isLayerUpToDate()
+{
+    int width, height;
+    this->getLayerSize(&width, &height);
+
+    return this->layer->width == width && this->layer->height == height && this->layerThemeVariant == Application::getThemeVariant();
+}
+
+void View::drawLayer(FrameContext* ctx)
+{
+    float alpha = this->getAlpha();
+    if (alpha <= 0.0f)
+        return;
+
+    Rect frame  = this->getFrame();
+    float scale = Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
+
+    NVGpaint paint = nvgImagePattern(ctx->vg, frame.getMinX(), frame.getMinY(),
+        this->layer->width / scale, this->layer->height / scale, 0, this->layer->image, alpha);
+
+    nvgBeginPath(ctx->vg);
+    nvgRect(ctx->vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight());
+    nvgFillPaint(ctx->vg, paint);
+    nvgFill(ctx->vg);
+}
+
+void View::renderLayer(FrameContext* ctx)
+{
+    VideoContext* videoContext = Application::getPlatform()->getVideoContext();
+
+    int width, height;
+    this->getLayerSize(&width, &height);
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (this->layer && (this->layer->width != width || this->layer->height != height))
+    {
+        Application::releaseLayerFramebuffer(this->layer);
+        this->layer = nullptr;
+    }
+
+    if (!this->layer)
+    {
+        this->layer = Application::acquireLayerFramebuffer(width, height);
+
+        if (!this->layer)
+        {
+            Logger::warning("Cached layers are not supported by the video context, drawing {} directly", this->describe());
+            this->layerCached = false;
+            return;
+        }
+    }
+
+    float scaleFactor = videoContext->getScaleFactor();
+    Rect frame        = this->getFrame();
+
+    // Anything invalidating the layer while it renders is rendered by the next frame
+    this->layerDirty       = false;
+    this->layerRenderFrame = FrameClock::getFrameCount();
+
+    videoContext->bindFramebuffer(this->layer);
+    videoContext->clear(nvgRGBA(0, 0, 0, 0));
+
+    nvgBeginFrame(ctx->vg, width / scaleFactor, height / scaleFactor, scaleFactor);
+    nvgScale(ctx->vg, Application::windowScale, Application::windowScale);
+    nvgTranslate(ctx->vg, -frame.getMinX(), -frame.getMinY());
+
+    // Alpha is applied when drawing the layer, render the content fully opaque
+    this->layerRendering = true;
+    this->frameContent(ctx);
+    this->layerRendering = false;
+
+    nvgEndFrame(ctx->vg);
+
+    videoContext->bindFramebuffer(nullptr);
+
+    this->layerThemeVariant = Application::getThemeVariant();
+}
+
 void View::frameHighlight(FrameContext* ctx)
 {
     if (this->alpha > 0.0f && this->collapseState != 0.0f && this->highlightAlpha > 0.0f && !this->hideHighlightBorder && !this->hideHighlight)
@@ -234,6 +471,7 @@ void View::playClickAnimation(bool reverse, bool animateBack, bool force)
         return;
 
     this->resetClickAnimation();
+    this->invalidateLayer();
 
     Style style = Application::getStyle();
 
@@ -379,6 +617,9 @@ void View::drawWireframe(FrameContext* ctx, Rect frame)
 
 void View::drawBorder(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame)
 {
+    if (this->cornerRadius > 0.0f && NinePatchCache::drawRoundedBorder(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), this->cornerRadius, this->borderThickness, a(this->borderColor)))
+        return;
+
     nvgBeginPath(vg);
     nvgStrokeColor(vg, a(this->borderColor));
     nvgStrokeWidth(vg, this->borderThickness);
@@ -407,6 +648,10 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
             break;
     }
 
+    if (NinePatchCache::drawShadow(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), this->cornerRadius,
+            shadowWidth, shadowFeather, shadowOffset, RGBA(0, 0, 0, shadowOpacity * alpha)))
+        return;
+
     NVGpaint shadowPaint = nvgBoxGradient(
         vg,
         frame.getMinX(), frame.getMinY() + shadowWidth,
@@ -429,6 +674,8 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
 
 void View::collapse(bool animated)
 {
+    this->invalidateLayer();
+
     if (animated)
     {
         Style style = Application::getStyle();
@@ -457,6 +704,8 @@ bool View::isCollapsed()
 
 void View::expand(bool animated)
 {
+    this->invalidateLayer();
+
     if (animated)
     {
         Style style = Application::getStyle();
@@ -480,7 +729,16 @@ void View::expand(bool animated)
 
 void View::setAlpha(float alpha)
 {
+    // Avoid damaging the parent every frame when views set the same alpha in draw()
+    if (this->alpha == alpha && !this->alpha.isRunning())
+        return;
+
     this->alpha = alpha;
+
+    if (this->hasParent())
+        this->getParent()->invalidateLayer();
+    else
+        this->damage();
 }
 
 void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style, bool background)
@@ -489,7 +747,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         return;
 
     nvgSave(vg);
-    nvgResetScissor(vg);
+    Application::resetScissor(vg);
 
     float padding      = this->highlightPadding;
     float cornerRadius = this->highlightCornerRadius;
@@ -503,7 +761,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     // Shake animation
     if (this->highlightShaking)
     {
-        Time curTime = getCPUTimeUsec() / 1000;
+        Time curTime = FrameClock::getFrameTime() / 1000;
         Time t       = (curTime - highlightShakeStart) / 10;
 
         if (t >= style["brls/animations/highlight_shake"])
@@ -535,10 +793,15 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     {
         // Background
         NVGcolor highlightBackgroundColor = theme["brls/highlight/background"];
-        nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha));
-        nvgBeginPath(vg);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgFill(vg);
+        NVGcolor backgroundColor          = RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha);
+
+        if (cornerRadius <= 0.0f || !NinePatchCache::drawRoundedRect(vg, x, y, width, height, cornerRadius, backgroundColor))
+        {
+            nvgFillColor(vg, backgroundColor);
+            nvgBeginPath(vg);
+            nvgRoundedRect(vg, x, y, width, height, cornerRadius);
+            nvgFill(vg);
+        }
     }
     else
     {
@@ -553,19 +816,24 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         float shadowOffset = style["brls/highlight/shadow_offset"];
 
         // Shadow
-        NVGpaint shadowPaint = nvgBoxGradient(vg,
-            x, y + style["brls/highlight/shadow_width"],
-            width, height,
-            cornerRadius * 2, style["brls/highlight/shadow_feather"],
-            RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha), TRANSPARENT);
+        if (!NinePatchCache::drawShadow(vg, x, y, width, height, cornerRadius,
+                style["brls/highlight/shadow_width"], style["brls/highlight/shadow_feather"], shadowOffset,
+                RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha)))
+        {
+            NVGpaint shadowPaint = nvgBoxGradient(vg,
+                x, y + style["brls/highlight/shadow_width"],
+                width, height,
+                cornerRadius * 2, style["brls/highlight/shadow_feather"],
+                RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha), TRANSPARENT);
 
-        nvgBeginPath(vg);
-        nvgRect(vg, x - shadowOffset, y - shadowOffset,
-            width + shadowOffset * 2, height + shadowOffset * 3);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgPathWinding(vg, NVG_HOLE);
-        nvgFillPaint(vg, shadowPaint);
-        nvgFill(vg);
+            nvgBeginPath(vg);
+            nvgRect(vg, x - shadowOffset, y - shadowOffset,
+                width + shadowOffset * 2, height + shadowOffset * 3);
+            nvgRoundedRect(vg, x, y, width, height, cornerRadius);
+            nvgPathWinding(vg, NVG_HOLE);
+            nvgFillPaint(vg, shadowPaint);
+            nvgFill(vg);
+        }
 
         // Border
         float gradientX, gradientY, color;
@@ -619,6 +887,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
 void View::setBackground(ViewBackground background)
 {
     this->background = background;
+    this->invalidateLayer();
 }
 
 void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame)
@@ -681,6 +950,9 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style, Rect f
         }
         case ViewBackground::SHAPE_COLOR:
         {
+            if (this->cornerRadius > 0.0f && NinePatchCache::drawRoundedRect(vg, x, y, width, height, this->cornerRadius, a(this->backgroundColor)))
+                break;
+
             nvgFillColor(vg, a(this->backgroundColor));
             nvgBeginPath(vg);
 
@@ -1126,13 +1398,50 @@ void View::setAlignSelf(AlignSelf alignSelf)
 
 void View::invalidate()
 {
+    // The content can change without moving the view, e.g. a text of the same size
+    this->damage();
+    this->invalidateLayout();
+}
+
+void View::invalidateLayout()
+{
+    if (this->layerCached && !this->layerFrozen)
+        this->layerDirty = true;
+
     if (YGNodeHasMeasureFunc(this->ygNode))
         YGNodeMarkDirty(this->ygNode);
 
     if (this->hasParent() && !this->detached)
-        this->getParent()->invalidate();
-    else
-        YGNodeCalculateLayout(this->ygNode, YGUndefined, YGUndefined, YGDirectionLTR);
+    {
+        this->getParent()->invalidateLayout();
+        return;
+    }
+
+    YGNodeCalculateLayout(this->ygNode, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    if (Application::isPartialRedrawEnabled())
+        this->damageNewLayout();
+}
+
+void View::damageNewLayout()
+{
+    // Yoga only flags the nodes it laid out again, their untouched
+    // subtrees moved with them and are covered by their damage
+    if (!YGNodeGetHasNewLayout(this->ygNode))
+        return;
+
+    YGNodeSetHasNewLayout(this->ygNode, false);
+
+    Rect frame = this->getFrame();
+    if (!(frame == this->drawnFrame))
+    {
+        this->damageFrame(this->drawnFrame);
+        this->damageFrame(frame);
+    }
+
+    uint32_t count = YGNodeGetChildCount(this->ygNode);
+    for (uint32_t i = 0; i < count; i++)
+        ((View*)YGNodeGetContext(YGNodeGetChild(this->ygNode, i)))->damageNewLayout();
 }
 
 Rect View::getFrame()
@@ -1207,6 +1516,7 @@ bool View::isDetached()
 
 void View::onFocusGained()
 {
+    this->invalidateLayer();
     this->focused = true;
 
     Style style = Application::getStyle();
@@ -1233,6 +1543,7 @@ GenericEvent* View::getFocusLostEvent()
 
 void View::onFocusLost()
 {
+    this->invalidateLayer();
     this->focused = false;
 
     Style style = Application::getStyle();
@@ -1282,6 +1593,9 @@ void View::show(std::function<void(void)> cb, bool animate, float animationDurat
 
     this->fadeIn = true;
 
+    if (this->hasParent())
+        this->getParent()->invalidateLayer();
+
     if (animate)
     {
         this->alpha.reset(0.0f);
@@ -1323,6 +1637,9 @@ void View::hide(std::function<void(void)> cb, bool animated, float animationDura
     this->hidden = true;
     this->fadeIn = false;
 
+    if (this->hasParent())
+        this->getParent()->invalidateLayer();
+
     if (animated)
     {
         this->alpha.reset(1.0f);
@@ -1438,7 +1755,16 @@ View::~View()
     highlightAlpha.stop();
     collapseState.stop();
 
-    YGNodeFree(this->ygNode);
+    if (this->layerCached)
+        Application::cancelLayerRender(this);
+
+    if (this->layer)
+        Application::releaseLayerFramebuffer(this->layer);
+
+    if (this->arena)
+        this->arena->freeNode(this->ygNode);
+    else
+        YGNodeFree(this->ygNode);
 
     if (deletionToken)
         *deletionToken = true;
@@ -1730,21 +2056,48 @@ bool View::isXMLAttributeValid(std::string attributeName)
 }
 
 View* View::createFromXMLResource(std::string name)
+{
+    tinyxml2::XMLDocument* document = View::loadXMLResource(name);
+
+    View* view = View::createFromXMLElement(document->RootElement());
+    view->bindXMLDocument(document);
+    return view;
+}
+
+View* View::createFromXMLString(std::string_view xml)
+{
+    tinyxml2::XMLDocument* document = View::loadXMLString(xml);
+
+    View* view = View::createFromXMLElement(document->RootElement());
+    view->bindXMLDocument(document);
+    return view;
+}
+
+View* View::createFromXMLFile(std::string path)
+{
+    tinyxml2::XMLDocument* document = View::loadXMLFile(path);
+
+    View* view = View::createFromXMLElement(document->RootElement());
+    view->bindXMLDocument(document);
+    return view;
+}
+
+tinyxml2::XMLDocument* View::loadXMLResource(std::string name)
 {
     // Check if custom xml file exists
     if (!View::CUSTOM_RESOURCES_PATH.empty() && std::ifstream { View::CUSTOM_RESOURCES_PATH + "xml/" + name }.good())
     {
-        return View::createFromXMLFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
+        return View::loadXMLFile(View::CUSTOM_RESOURCES_PATH + "xml/" + name);
     }
 
 #ifdef USE_LIBROMFS
-    return View::createFromXMLString(romfs::get("xml/" + name).string());
+    return View::loadXMLString(romfs::get("xml/" + name).string());
 #else
-    return View::createFromXMLFile(std::string(BRLS_RESOURCES) + "xml/" + name);
+    return View::loadXMLFile(std::string(BRLS_RESOURCES) + "xml/" + name);
 #endif
 }
 
-View* View::createFromXMLString(std::string_view xml)
+tinyxml2::XMLDocument* View::loadXMLString(std::string_view xml)
 {
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
     tinyxml2::XMLError error        = document->Parse(xml.data());
@@ -1752,17 +2105,13 @@ View* View::createFromXMLString(std::string_view xml)
     if (error != tinyxml2::XMLError::XML_SUCCESS)
         fatal("Invalid XML when creating View from XML: error " + std::to_string(error));
 
-    tinyxml2::XMLElement* root = document->RootElement();
-
-    if (!root)
+    if (!document->RootElement())
         fatal("Invalid XML: no element found");
 
-    View* view = View::createFromXMLElement(root);
-    view->bindXMLDocument(document);
-    return view;
+    return document;
 }
 
-View* View::createFromXMLFile(std::string path)
+tinyxml2::XMLDocument* View::loadXMLFile(std::string path)
 {
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
     tinyxml2::XMLError error        = document->LoadFile(path.c_str());
@@ -1770,17 +2119,13 @@ View* View::createFromXMLFile(std::string path)
     if (error != tinyxml2::XMLError::XML_SUCCESS)
         fatal("Unable to load XML file \"" + path + "\": error " + std::to_string(error));
 
-    tinyxml2::XMLElement* element = document->RootElement();
-
-    if (!element)
+    if (!document->RootElement())
         fatal("Unable to load XML file \"" + path + "\": no root element found, is the file empty?");
 
-    View* view = View::createFromXMLElement(element);
-    view->bindXMLDocument(document);
-    return view;
+    return document;
 }
 
-View* View::createFromXMLElement(tinyxml2::XMLElement* element)
+View* View::createFromXMLElement(tinyxml2::XMLElement* element, bool inflateChildren)
 {
     if (!element)
         return nullptr;
@@ -1822,6 +2167,9 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
         view->applyXMLAttributes(element);
     }
 
+    if (!inflateChildren)
+        return view;
+
     unsigned count = 0;
     unsigned max   = view->getMaximumAllowedXMLElements();
     for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
@@ -2218,6 +2566,10 @@ void View::registerCommonAttributes()
         this->setClipsToBounds(value);
     });
 
+    this->registerBoolXMLAttribute("layerCached", [this](bool value) {
+        this->setLayerCached(value);
+    });
+
     this->registerBoolXMLAttribute("culled", [this](float value) {
         this->setCulled(value);
     });
@@ -2229,12 +2581,29 @@ void View::registerCommonAttributes()
 
 void View::setTranslationY(float translationY)
 {
+    if (this->translation.y == translationY)
+        return;
+
     this->translation.y = translationY;
+    this->invalidateTranslation();
 }
 
 void View::setTranslationX(float translationX)
 {
+    if (this->translation.x == translationX)
+        return;
+
     this->translation.x = translationX;
+    this->invalidateTranslation();
+}
+
+void View::invalidateTranslation()
+{
+    // The parent area covers both the old and the new position
+    if (this->hasParent())
+        this->getParent()->invalidateLayer();
+    else
+        Application::damageAll();
 }
 
 void View::setVisibility(Visibility visibility)
@@ -2250,6 +2619,9 @@ void View::setVisibility(Visibility visibility)
         this->invalidate();
     }
 
+    if (this->visibility != visibility)
+        this->damage();
+
     this->visibility = visibility;
 
     if (visibility == Visibility::VISIBLE)
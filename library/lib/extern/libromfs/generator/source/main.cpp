@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -31,6 +33,22 @@ namespace {
         return string;
     }
 
+    // Must match romfs::impl::hash()
+    std::uint32_t hash(const std::string &string) {
+        std::uint32_t hash = 2166136261u;
+        for (char c : string) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    struct Entry {
+        std::string path;
+        std::string parent;
+        std::uint64_t identifier;
+    };
+
 }
 
 int main(int argc, char* argv[]) {
@@ -43,8 +61,7 @@ int main(int argc, char* argv[]) {
     std::printf("[libromfs] Resource Folder: %s\n", argv[2]);
 
     outputFile << "#include <romfs/romfs.hpp>\n\n";
-    outputFile << "#include <array>\n";
-    outputFile << "#include <map>\n";
+    outputFile << "#include <cstdint>\n";
 
     outputFile << "\n\n";
     outputFile << "/* Resource definitions */\n";
@@ -63,7 +80,8 @@ int main(int argc, char* argv[]) {
             continue ;
         }
 
-        outputFile << "static std::array<std::uint8_t, " << fs::file_size(p) + 1 << "> " << "resource_" + std::string(argv[1]) + "_" << identifierCount << " = {\n";
+        // Resources are const so they stay in read only memory and are used in place
+        outputFile << "alignas(romfs::ResourceAlignment) static const std::uint8_t " << "resource_" + std::string(argv[1]) + "_" << identifierCount << "[" << fs::file_size(p) + 1 << "] = {\n";
         outputFile << "    ";
 
         std::vector<std::byte> bytes;
@@ -81,6 +99,8 @@ int main(int argc, char* argv[]) {
 
         outputFile << "\n 0x00 };\n\n";
 
+        outputFile << "static constexpr std::size_t resource_" + std::string(argv[1]) + "_" << identifierCount << "_size = " << bytes.size() << ";\n\n";
+
         paths.push_back(relativePath);
 
         identifierCount++;
@@ -89,35 +109,55 @@ int main(int argc, char* argv[]) {
     outputFile << "\n";
 
     {
-        outputFile << "/* Resource map */\n";
-        outputFile << "const std::map<fs::path, romfs::Resource>& RomFs_" + std::string(argv[1]) + "_get_resources() {\n";
-        outputFile << "    static std::map<fs::path, romfs::Resource> resources = {\n";
-
+        // Sort by parent directory then path, so a directory is a contiguous range
+        std::vector<Entry> entries;
         for (std::uint64_t i = 0; i < identifierCount; i++) {
-
-            std::printf("[libromfs] Bundling resource: %s\n", paths[i].string().c_str());
-
-            outputFile << "        " << "{ \"" << toPathString(paths[i].string()) << "\", romfs::Resource({ reinterpret_cast<std::byte*>(resource_" + std::string(argv[1]) + "_" << i << ".data()), " << "resource_" + std::string(argv[1]) + "_" << i << ".size() - 1 }) " << "},\n";
+            std::string path = paths[i].generic_string();
+            std::size_t slash = path.rfind('/');
+            entries.push_back({ path, slash == std::string::npos ? "" : path.substr(0, slash), i });
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) {
+            return lhs.parent != rhs.parent ? lhs.parent < rhs.parent : lhs.path < rhs.path;
+        });
+
+        // Open addressing hash table with linear probing, at most half full
+        std::size_t slotCount = 1;
+        while (slotCount < entries.size() * 2)
+            slotCount *= 2;
+
+        std::vector<std::uint32_t> slots(slotCount, 0);
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            std::size_t slot = hash(entries[i].path) & (slotCount - 1);
+            while (slots[slot] != 0)
+                slot = (slot + 1) & (slotCount - 1);
+            slots[slot] = static_cast<std::uint32_t>(i + 1);
         }
-        outputFile << "    };";
-
-        outputFile << "\n\n    return resources;\n";
-        outputFile << "}\n\n";
-    }
 
-    outputFile << "\n\n";
+        outputFile << "/* Resource index */\n";
+        outputFile << "static constexpr romfs::impl::ResourceEntry entries_" + std::string(argv[1]) + "[] = {\n";
 
-    {
-        outputFile << "/* Resource paths */\n";
-        outputFile << "const std::vector<fs::path>& RomFs_" + std::string(argv[1]) + "_get_paths() {\n";
-        outputFile << "    static std::vector<fs::path> paths = {\n";
+        for (const auto &entry : entries) {
+            std::printf("[libromfs] Bundling resource: %s\n", entry.path.c_str());
 
-        for (std::uint64_t i = 0; i < identifierCount; i++) {
-            outputFile << "        \"" << toPathString(paths[i].string()) << "\",\n";
+            std::string resource = "resource_" + std::string(argv[1]) + "_" + std::to_string(entry.identifier);
+            outputFile << "    { \"" << toPathString(entry.path) << "\", " << entry.parent.size() << ", " << hash(entry.path) << "u, "
+                       << "romfs::Resource(" << resource << ", " << resource << "_size) },\n";
+        }
+        if (entries.empty())
+            outputFile << "    { \"\", 0, 0, romfs::Resource() },\n";
+        outputFile << "};\n\n";
+
+        outputFile << "static constexpr std::uint32_t slots_" + std::string(argv[1]) + "[] = {";
+        for (std::size_t i = 0; i < slots.size(); i++) {
+            if (i % 16 == 0)
+                outputFile << "\n    ";
+            outputFile << slots[i] << ", ";
         }
-        outputFile << "    };";
+        outputFile << "\n};\n\n";
 
-        outputFile << "\n\n    return paths;\n";
+        outputFile << "const romfs::impl::ResourceIndex& RomFs_" + std::string(argv[1]) + "_get_index() {\n";
+        outputFile << "    static constexpr romfs::impl::ResourceIndex index = { entries_" + std::string(argv[1]) + ", " << entries.size() << ", slots_" + std::string(argv[1]) + ", " << slotCount << " };\n";
+        outputFile << "    return index;\n";
         outputFile << "}\n\n";
     }
 
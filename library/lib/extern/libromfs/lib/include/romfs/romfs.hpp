@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 #if __cplusplus > 202002L
 #include <span>
@@ -23,19 +24,30 @@ namespace fs = std::filesystem;
 
 namespace romfs {
 
+    // Every resource is aligned on this boundary and followed by a null byte,
+    // so it can be parsed in place (images, fonts, xml, json...)
+    constexpr std::size_t ResourceAlignment = 16;
+
     class Resource {
     public:
-        constexpr Resource() : m_content() {}
-        explicit constexpr Resource(const nonstd::span<std::byte> &content) : m_content(content) {}
+        constexpr Resource() : m_data(nullptr), m_size(0) {}
+        constexpr Resource(const std::uint8_t *data, std::size_t size) : m_data(data), m_size(size) {}
+        explicit Resource(const nonstd::span<const std::byte> &content)
+            : m_data(reinterpret_cast<const std::uint8_t*>(content.data())), m_size(content.size()) {}
 
         [[nodiscard]]
-        constexpr const std::byte* data() const {
-            return this->m_content.data();
+        const std::byte* data() const {
+            return reinterpret_cast<const std::byte*>(this->m_data);
         }
 
         [[nodiscard]]
         constexpr std::size_t size() const {
-            return this->m_content.size();
+            return this->m_size;
+        }
+
+        [[nodiscard]]
+        nonstd::span<const std::byte> span() const {
+            return { this->data(), this->size() };
         }
 
         [[nodiscard]]
@@ -50,24 +62,72 @@ namespace romfs {
 
         [[nodiscard]]
         constexpr bool valid() const {
-            return !this->m_content.empty() && this->m_content.data() != nullptr;
+            return this->m_size != 0 && this->m_data != nullptr;
         }
 
     private:
-        const nonstd::span<const std::byte> m_content;
+        const std::uint8_t *m_data;
+        std::size_t m_size;
     };
 
     namespace impl {
 
-        [[nodiscard]] const Resource& ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(const fs::path &path);
-        [[nodiscard]] std::vector<fs::path> ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(const fs::path &path);
+        // Generated by libromfs-generator, entries are sorted by parent directory then path
+        struct ResourceEntry {
+            std::string_view path;
+            std::size_t parentLength;
+            std::uint32_t hash;
+            Resource resource;
+        };
+
+        struct ResourceIndex {
+            const ResourceEntry *entries;
+            std::size_t count;
+
+            // Open addressing hash table of entry index + 1, 0 is an empty slot.
+            // The size is a power of two.
+            const std::uint32_t *slots;
+            std::size_t slotCount;
+        };
+
+        // FNV-1a, the generator uses the same function
+        constexpr std::uint32_t hash(std::string_view string) {
+            std::uint32_t hash = 2166136261u;
+            for (char c : string) {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        [[nodiscard]] const Resource* ROMFS_CONCAT(find_, LIBROMFS_PROJECT_NAME)(std::string_view path);
+        [[nodiscard]] const Resource& ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(std::string_view path);
+        [[nodiscard]] std::vector<fs::path> ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(std::string_view path);
         [[nodiscard]] const std::string& ROMFS_CONCAT(name_, LIBROMFS_PROJECT_NAME)();
 
     }
 
-    [[nodiscard]] inline const Resource& get(const fs::path &path) { return impl::ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(path); }
-    [[nodiscard]] inline std::vector<fs::path> list(const fs::path &path = {}) { return impl::ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(path); }
+    [[nodiscard]] inline const Resource& get(std::string_view path) { return impl::ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(path); }
+    [[nodiscard]] inline const Resource& get(const std::string &path) { return get(std::string_view(path)); }
+    [[nodiscard]] inline const Resource& get(const char *path) { return get(std::string_view(path)); }
+    [[nodiscard]] inline const Resource& get(const fs::path &path) { return get(path.generic_string()); }
+
+    // Returns nullptr if there is no resource at the given path, where get() throws
+    [[nodiscard]] inline const Resource* find(std::string_view path) { return impl::ROMFS_CONCAT(find_, LIBROMFS_PROJECT_NAME)(path); }
+    [[nodiscard]] inline const Resource* find(const std::string &path) { return find(std::string_view(path)); }
+    [[nodiscard]] inline const Resource* find(const char *path) { return find(std::string_view(path)); }
+    [[nodiscard]] inline const Resource* find(const fs::path &path) { return find(path.generic_string()); }
+
+    [[nodiscard]] inline bool exists(std::string_view path) { return find(path) != nullptr; }
+    [[nodiscard]] inline bool exists(const std::string &path) { return exists(std::string_view(path)); }
+    [[nodiscard]] inline bool exists(const char *path) { return exists(std::string_view(path)); }
+    [[nodiscard]] inline bool exists(const fs::path &path) { return exists(path.generic_string()); }
+
+    [[nodiscard]] inline std::vector<fs::path> list(std::string_view path = {}) { return impl::ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(path); }
+    [[nodiscard]] inline std::vector<fs::path> list(const std::string &path) { return list(std::string_view(path)); }
+    [[nodiscard]] inline std::vector<fs::path> list(const char *path) { return list(std::string_view(path)); }
+    [[nodiscard]] inline std::vector<fs::path> list(const fs::path &path) { return list(path.generic_string()); }
     [[nodiscard]] inline const std::string& name() { return impl::ROMFS_CONCAT(name_, LIBROMFS_PROJECT_NAME)(); }
 
 
-}
\ No newline at end of file
+}
@@ -1,32 +1,71 @@
 #include <romfs/romfs.hpp>
 
-#include <map>
+#include <algorithm>
+#include <stdexcept>
 
-const std::map<fs::path, romfs::Resource>& ROMFS_CONCAT(ROMFS_NAME, _get_resources)();
-const std::vector<fs::path>& ROMFS_CONCAT(ROMFS_NAME, _get_paths)();
+const romfs::impl::ResourceIndex& ROMFS_CONCAT(ROMFS_NAME, _get_index)();
 const std::string& ROMFS_CONCAT(ROMFS_NAME, _get_name)();
 
 namespace romfs {
 
-    const romfs::Resource &impl::ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(const fs::path &path) {
-        try {
-            return ROMFS_CONCAT(ROMFS_NAME, _get_resources)().at(path);
-        } catch (std::out_of_range &ignored) {
-            throw std::invalid_argument(std::string("Invalid romfs resource path for '" + romfs::name() + "' : ") + path.string());
+    static std::string_view parentOf(const impl::ResourceEntry &entry) {
+        return entry.path.substr(0, entry.parentLength);
+    }
+
+    const romfs::Resource *impl::ROMFS_CONCAT(find_, LIBROMFS_PROJECT_NAME)(std::string_view path) {
+        const auto &index = ROMFS_CONCAT(ROMFS_NAME, _get_index)();
+
+        std::uint32_t hash = impl::hash(path);
+        std::size_t mask   = index.slotCount - 1;
+
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            std::uint32_t entryIndex = index.slots[slot];
+            if (entryIndex == 0)
+                return nullptr;
+
+            const auto &entry = index.entries[entryIndex - 1];
+            if (entry.hash == hash && entry.path == path)
+                return &entry.resource;
         }
     }
 
-    std::vector<fs::path> impl::ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(const fs::path &parent) {
-        if (parent.empty()) {
-            return ROMFS_CONCAT(ROMFS_NAME, _get_paths)();
-        } else {
-            std::vector<fs::path> result;
-            for (const auto &p : ROMFS_CONCAT(ROMFS_NAME, _get_paths)())
-                if (p.parent_path() == parent)
-                    result.push_back(p);
+    const romfs::Resource &impl::ROMFS_CONCAT(get_, LIBROMFS_PROJECT_NAME)(std::string_view path) {
+        const Resource *resource = impl::ROMFS_CONCAT(find_, LIBROMFS_PROJECT_NAME)(path);
+        if (resource == nullptr)
+            throw std::invalid_argument(std::string("Invalid romfs resource path for '" + romfs::name() + "' : ") + std::string(path));
+
+        return *resource;
+    }
 
+    std::vector<fs::path> impl::ROMFS_CONCAT(list_, LIBROMFS_PROJECT_NAME)(std::string_view parent) {
+        const auto &index = ROMFS_CONCAT(ROMFS_NAME, _get_index)();
+        const auto *begin = index.entries;
+        const auto *end   = index.entries + index.count;
+
+        std::vector<fs::path> result;
+
+        if (parent.empty()) {
+            result.reserve(index.count);
+            for (const auto *entry = begin; entry != end; entry++)
+                result.emplace_back(entry->path);
             return result;
         }
+
+        if (parent.back() == '/')
+            parent.remove_suffix(1);
+
+        // Entries of the same directory are contiguous
+        auto range = std::equal_range(begin, end, parent, [](const auto &lhs, const auto &rhs) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(lhs)>, std::string_view>)
+                return lhs < parentOf(rhs);
+            else
+                return parentOf(lhs) < rhs;
+        });
+
+        for (const auto *entry = range.first; entry != range.second; entry++)
+            result.emplace_back(entry->path);
+
+        return result;
     }
 
     const std::string &impl::ROMFS_CONCAT(name_, LIBROMFS_PROJECT_NAME)() {
@@ -839,7 +839,7 @@ int nvgCreateImage(NVGcontext* ctx, const char* filename, int imageFlags)
 	return image;
 }
 
-int nvgCreateImageMem(NVGcontext* ctx, int imageFlags, unsigned char* data, int ndata)
+int nvgCreateImageMem(NVGcontext* ctx, int imageFlags, const unsigned char* data, int ndata)
 {
 	int w, h, n, image;
 	unsigned char* img = stbi_load_from_memory(data, ndata, &w, &h, &n, 4);
@@ -2281,6 +2281,52 @@ void nvgFill(NVGcontext* ctx)
 	}
 }
 
+void nvgImageQuads(NVGcontext* ctx, int image, NVGcolor color, const float* quads, int nquads)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint;
+	NVGvertex* verts;
+	int i, nverts = nquads * 6;
+
+	if (nquads <= 0) return;
+
+	verts = nvg__allocTempVerts(ctx, nverts);
+	if (verts == NULL) return;
+
+	for (i = 0; i < nquads; i++) {
+		const float* q = &quads[i*8];
+		NVGvertex* v = &verts[i*6];
+		float c[8];
+
+		// Transform corners, same winding as glyph quads.
+		nvgTransformPoint(&c[0],&c[1], state->xform, q[0], q[1]);
+		nvgTransformPoint(&c[2],&c[3], state->xform, q[0]+q[2], q[1]);
+		nvgTransformPoint(&c[4],&c[5], state->xform, q[0]+q[2], q[1]+q[3]);
+		nvgTransformPoint(&c[6],&c[7], state->xform, q[0], q[1]+q[3]);
+
+		nvg__vset(&v[0], c[0], c[1], q[4], q[5]);
+		nvg__vset(&v[1], c[4], c[5], q[6], q[7]);
+		nvg__vset(&v[2], c[2], c[3], q[6], q[5]);
+		nvg__vset(&v[3], c[0], c[1], q[4], q[5]);
+		nvg__vset(&v[4], c[6], c[7], q[4], q[7]);
+		nvg__vset(&v[5], c[4], c[5], q[6], q[7]);
+	}
+
+	memset(&paint, 0, sizeof(paint));
+	nvgTransformIdentity(paint.xform);
+	paint.image = image;
+	paint.innerColor = color;
+	paint.outerColor = color;
+
+	// Apply global alpha
+	paint.innerColor.a *= state->alpha;
+	paint.outerColor.a *= state->alpha;
+
+	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, nverts, ctx->fringeWidth);
+
+	ctx->drawCallCount++;
+}
+
 void nvgStroke(NVGcontext* ctx)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -56,15 +56,8 @@ bool DesktopFontLoader::loadFont(const std::string& name, const std::string& pat
     if (path.rfind("@res/", 0) == 0)
     {
         // font is inside the romfs
-        try
-        {
-            auto& font = romfs::get(path.substr(5));
-            if (font.valid() && Application::loadFontFromMemory(name, (void*)font.data(), font.size(), false))
-                return true;
-        }
-        catch (...)
-        {
-        }
+        if (Application::loadFontFromMemory(name, ByteBuffer::fromRes(path.substr(5))))
+            return true;
     } else
 #endif
     if (access(path.c_str(), F_OK) != -1 && Application::loadFontFromFile(name, path)) {
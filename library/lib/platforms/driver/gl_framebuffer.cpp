@@ -0,0 +1,77 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/platforms/driver/gl_framebuffer.hpp>
+
+#if defined(__PSV__) || defined(PS4)
+#include <GLES2/gl2.h>
+#else
+#include <glad/glad.h>
+#endif
+#include <nanovg.h>
+#include <nanovg_gl_utils.h>
+
+namespace brls
+{
+
+struct GLVideoFramebuffer : public VideoFramebuffer
+{
+    NVGLUframebuffer* fb = nullptr;
+};
+
+VideoFramebuffer* GLFramebufferManager::createFramebuffer(NVGcontext* vg, int width, int height)
+{
+    NVGLUframebuffer* fb = nvgluCreateFramebuffer(vg, width, height, 0);
+    if (!fb)
+        return nullptr;
+
+    GLVideoFramebuffer* framebuffer = new GLVideoFramebuffer();
+    framebuffer->image              = fb->image;
+    framebuffer->width              = width;
+    framebuffer->height             = height;
+    framebuffer->fb                 = fb;
+    return framebuffer;
+}
+
+void GLFramebufferManager::bindFramebuffer(VideoFramebuffer* framebuffer)
+{
+    if (framebuffer)
+    {
+        if (!this->framebufferBound)
+            glGetIntegerv(GL_VIEWPORT, this->windowViewport);
+
+        nvgluBindFramebuffer(((GLVideoFramebuffer*)framebuffer)->fb);
+        glViewport(0, 0, framebuffer->width, framebuffer->height);
+        this->framebufferBound = true;
+    }
+    else if (this->framebufferBound)
+    {
+        nvgluBindFramebuffer(nullptr);
+        glViewport(this->windowViewport[0], this->windowViewport[1], this->windowViewport[2], this->windowViewport[3]);
+        this->framebufferBound = false;
+    }
+}
+
+void GLFramebufferManager::deleteFramebuffer(VideoFramebuffer* framebuffer)
+{
+    if (!framebuffer)
+        return;
+
+    nvgluDeleteFramebuffer(((GLVideoFramebuffer*)framebuffer)->fb);
+    delete (GLVideoFramebuffer*)framebuffer;
+}
+
+} // namespace brls
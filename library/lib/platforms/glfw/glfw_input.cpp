@@ -136,9 +136,32 @@ static void glfwTouchCallback(GLFWwindow* window, int touch, int action, double
     touchState.position.y = (float)(ypos * scaleFactor);
     touchStateStatus      = touchState.pressed ? GLFW_PRESS : GLFW_STICKY;
     touchUpdate          |= touchState.pressed;
+    Application::getPlatform()->getInputManager()->pushTouchEvent(touchState);
     Application::setActiveEvent(true);
 }
 
+// Returns the button a keyboard key is mapped to, as in updateUnifiedControllerState()
+static ControllerButton glfwKeyToButton(int key)
+{
+    for (size_t i = 2; i < GLFW_GAMEPAD_BUTTON_MAX; i++)
+    {
+        if (GLFW_GAMEPAD_TO_KEYBOARD[i] == (size_t)key)
+            return (ControllerButton)GLFW_BUTTONS_MAPPING[i];
+    }
+
+    bool swap = Application::isSwapInputKeys();
+    switch (key)
+    {
+        case GLFW_KEY_KP_ENTER:
+        case GLFW_KEY_ENTER:
+            return swap ? BUTTON_B : BUTTON_A;
+        case GLFW_KEY_ESCAPE:
+            return swap ? BUTTON_A : BUTTON_B;
+        default:
+            return _BUTTON_MAX;
+    }
+}
+
 void GLFWInputManager::keyboardCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     auto* self = (GLFWInputManager*)Application::getPlatform()->getInputManager();
@@ -152,6 +175,11 @@ void GLFWInputManager::keyboardCallback(GLFWwindow* window, int key, int scancod
     else
         Logger::debug("Key: NULL / Code: {} / Action: {}", key, action);
     self->getKeyboardKeyStateChanged()->fire(state);
+
+    ControllerButton button = glfwKeyToButton(key);
+    if (button != _BUTTON_MAX && action != GLFW_REPEAT)
+        self->pushButtonEvent(button, action == GLFW_PRESS);
+
     Application::setActiveEvent(true);
 }
 
@@ -35,6 +35,7 @@
 #endif /* USE_GL2 */
 #endif /* __PSV__ */
 #include <nanovg_gl.h>
+#include <nanovg_gl_utils.h>
 #elif defined(BOREALIS_USE_METAL)
 static void* METAL_CONTEXT = nullptr;
 #include <borealis/platforms/glfw/driver/metal.hpp>
@@ -339,6 +340,11 @@ GLFWVideoContext::GLFWVideoContext(const std::string& windowTitle, uint32_t wind
 #endif
     glfwSwapInterval(1);
 
+    GLFWmonitor* currentMonitor  = getCurrentMonitor(window);
+    const GLFWvidmode* videoMode = glfwGetVideoMode(currentMonitor ? currentMonitor : glfwGetPrimaryMonitor());
+    if (videoMode && videoMode->refreshRate > 0)
+        FrameClock::setFrameInterval(1000000 / videoMode->refreshRate);
+
     Logger::info("glfw: GL Vendor: {}", (const char*)glGetString(GL_VENDOR));
     Logger::info("glfw: GL Renderer: {}", (const char*)glGetString(GL_RENDERER));
     Logger::info("glfw: GL Version: {}", (const char*)glGetString(GL_VERSION));
@@ -512,6 +518,52 @@ NVGcontext* GLFWVideoContext::getNVGContext()
     return this->nvgContext;
 }
 
+VideoFrameStats GLFWVideoContext::getFrameStats()
+{
+    VideoFrameStats stats;
+#ifdef BOREALIS_USE_OPENGL
+    NVGglFrameStats glStats;
+#if defined(NANOVG_GL2)
+    nvglFrameStatsGL2(this->nvgContext, &glStats);
+#elif defined(NANOVG_GLES2)
+    nvglFrameStatsGLES2(this->nvgContext, &glStats);
+#elif defined(NANOVG_GLES3)
+    nvglFrameStatsGLES3(this->nvgContext, &glStats);
+#else
+    nvglFrameStatsGL3(this->nvgContext, &glStats);
+#endif
+    stats.drawCalls      = glStats.drawCalls;
+    stats.vertices       = glStats.vertices;
+    stats.textureBinds   = glStats.textureBinds;
+    stats.uniformUploads = glStats.uniformUploads;
+    stats.batchedCalls   = glStats.batchedCalls;
+#endif
+    return stats;
+}
+
+VideoFramebuffer* GLFWVideoContext::createFramebuffer(int width, int height)
+{
+#ifdef BOREALIS_USE_OPENGL
+    return this->framebuffers.createFramebuffer(this->nvgContext, width, height);
+#else
+    return nullptr;
+#endif
+}
+
+void GLFWVideoContext::bindFramebuffer(VideoFramebuffer* framebuffer)
+{
+#ifdef BOREALIS_USE_OPENGL
+    this->framebuffers.bindFramebuffer(framebuffer);
+#endif
+}
+
+void GLFWVideoContext::deleteFramebuffer(VideoFramebuffer* framebuffer)
+{
+#ifdef BOREALIS_USE_OPENGL
+    this->framebuffers.deleteFramebuffer(framebuffer);
+#endif
+}
+
 int GLFWVideoContext::getCurrentMonitorIndex()
 {
     if (!this->window)
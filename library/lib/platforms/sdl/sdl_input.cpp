@@ -379,8 +379,35 @@ static inline int getKeyboardKeys(SDL_Scancode code)
     }
 }
 
+// Returns the button a keyboard key is mapped to, as in updateUnifiedControllerState()
+static ControllerButton sdlKeyToButton(SDL_Scancode code)
+{
+    for (size_t i = 2; i < SDL_GAMEPAD_BUTTON_MAX; i++)
+    {
+        if (SDL_GAMEPAD_TO_KEYBOARD[i] == (size_t)code)
+            return (ControllerButton)SDL_BUTTONS_MAPPING[i];
+    }
+
+    bool swap = Application::isSwapInputKeys();
+    switch (code)
+    {
+        case SDL_SCANCODE_KP_ENTER:
+        case SDL_SCANCODE_RETURN:
+            return swap ? BUTTON_B : BUTTON_A;
+        case SDL_SCANCODE_ESCAPE:
+        case SDL_SCANCODE_AC_BACK:
+            return swap ? BUTTON_A : BUTTON_B;
+        case SDL_SCANCODE_MENU:
+            return BUTTON_X;
+        default:
+            return _BUTTON_MAX;
+    }
+}
+
 static int sdlEventWatcher(void* data, SDL_Event* event)
 {
+    InputManager* inputManager = Application::getPlatform() ? Application::getPlatform()->getInputManager() : nullptr;
+
     if (event->type == SDL_CONTROLLERDEVICEADDED)
     {
         SDL_GameController* controller = SDL_GameControllerOpen(event->cdevice.which);
@@ -409,6 +436,24 @@ static int sdlEventWatcher(void* data, SDL_Event* event)
     else if (event->type == SDL_KEYDOWN || event->type == SDL_KEYUP)
     {
         keyboardKeys[event->key.keysym.scancode] = event->type == SDL_KEYDOWN ? SDL_PRESSED : SDL_STICKY;
+
+        ControllerButton button = sdlKeyToButton(event->key.keysym.scancode);
+        if (inputManager && button != _BUTTON_MAX && !event->key.repeat)
+            inputManager->pushButtonEvent(button, event->type == SDL_KEYDOWN);
+    }
+    else if (event->type == SDL_CONTROLLERBUTTONDOWN || event->type == SDL_CONTROLLERBUTTONUP)
+    {
+        if (inputManager && event->cbutton.button < SDL_GAMEPAD_BUTTON_MAX)
+            inputManager->pushButtonEvent((ControllerButton)SDL_BUTTONS_MAPPING[event->cbutton.button], event->type == SDL_CONTROLLERBUTTONDOWN);
+    }
+    else if (inputManager && (event->type == SDL_FINGERDOWN || event->type == SDL_FINGERUP))
+    {
+        RawTouchState touch;
+        touch.fingerId   = (int)event->tfinger.fingerId;
+        touch.pressed    = event->type == SDL_FINGERDOWN;
+        touch.position.x = Application::contentWidth * event->tfinger.x;
+        touch.position.y = Application::contentHeight * event->tfinger.y;
+        inputManager->pushTouchEvent(touch);
     }
     Application::setActiveEvent(true);
     return 0;
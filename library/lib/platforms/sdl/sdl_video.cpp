@@ -45,6 +45,7 @@ extern "C"
 #endif
 #endif
 #include <nanovg_gl.h>
+#include <nanovg_gl_utils.h>
 #elif defined(BOREALIS_USE_D3D11)
 #include <nanovg_d3d11.h>
 
@@ -273,6 +274,10 @@ SDLVideoContext::SDLVideoContext(std::string windowTitle, uint32_t windowWidth,
 #endif
     SDL_GL_SetSwapInterval(1);
 
+    SDL_DisplayMode displayMode;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &displayMode) == 0 && displayMode.refresh_rate > 0)
+        FrameClock::setFrameInterval(1000000 / displayMode.refresh_rate);
+
     Logger::info("sdl: GL Vendor: {}", (const char*)glGetString(GL_VENDOR));
     Logger::info("sdl: GL Renderer: {}", (const char*)glGetString(GL_RENDERER));
     Logger::info("sdl: GL Version: {}", (const char*)glGetString(GL_VERSION));
@@ -415,6 +420,52 @@ NVGcontext* SDLVideoContext::getNVGContext()
     return this->nvgContext;
 }
 
+VideoFrameStats SDLVideoContext::getFrameStats()
+{
+    VideoFrameStats stats;
+#ifdef BOREALIS_USE_OPENGL
+    NVGglFrameStats glStats;
+#if defined(NANOVG_GL2)
+    nvglFrameStatsGL2(this->nvgContext, &glStats);
+#elif defined(NANOVG_GLES2)
+    nvglFrameStatsGLES2(this->nvgContext, &glStats);
+#elif defined(NANOVG_GLES3)
+    nvglFrameStatsGLES3(this->nvgContext, &glStats);
+#else
+    nvglFrameStatsGL3(this->nvgContext, &glStats);
+#endif
+    stats.drawCalls      = glStats.drawCalls;
+    stats.vertices       = glStats.vertices;
+    stats.textureBinds   = glStats.textureBinds;
+    stats.uniformUploads = glStats.uniformUploads;
+    stats.batchedCalls   = glStats.batchedCalls;
+#endif
+    return stats;
+}
+
+VideoFramebuffer* SDLVideoContext::createFramebuffer(int width, int height)
+{
+#ifdef BOREALIS_USE_OPENGL
+    return this->framebuffers.createFramebuffer(this->nvgContext, width, height);
+#else
+    return nullptr;
+#endif
+}
+
+void SDLVideoContext::bindFramebuffer(VideoFramebuffer* framebuffer)
+{
+#ifdef BOREALIS_USE_OPENGL
+    this->framebuffers.bindFramebuffer(framebuffer);
+#endif
+}
+
+void SDLVideoContext::deleteFramebuffer(VideoFramebuffer* framebuffer)
+{
+#ifdef BOREALIS_USE_OPENGL
+    this->framebuffers.deleteFramebuffer(framebuffer);
+#endif
+}
+
 SDL_Window* SDLVideoContext::getSDLWindow()
 {
     return this->window;
@@ -71,6 +71,9 @@ SwitchVideoContext::SwitchVideoContext()
     this->renderer.emplace(this->framebufferWidth, this->framebufferHeight, this->device, this->queue, *this->imagesPool, *this->codePool, *this->dataPool);
     this->nvgContext = nvgCreateDk(&*this->renderer, NVG_ANTIALIAS | NVG_STENCIL_STROKES);
 
+    // The console always presents at 60Hz
+    FrameClock::setFrameInterval(1000000 / 60);
+
     Application::setWindowSize(this->framebufferWidth, this->framebufferHeight);
 }
 
@@ -0,0 +1,435 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// The stb_image built into nanovg only decodes all GIF frames at once,
+// use a private copy restricted to GIF to decode them one at a time
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_GIF
+#define STBI_NO_STDIO
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include <stb_image.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <array>
+#include <atomic>
+#include <borealis/core/application.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/views/animated_image.hpp>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "borealis/core/cache_helper.hpp"
+
+namespace brls
+{
+
+// Number of frames decoded ahead of the one on screen
+static const size_t FRAME_RING_SIZE = 3;
+
+// Browsers play GIF frames with a delay under 20ms at 100ms
+static const int MIN_FRAME_DELAY     = 20;
+static const int DEFAULT_FRAME_DELAY = 100;
+
+// Decoding state of one animation, shared between the view and the async thread
+// so that a frame being decoded can finish after the view is deleted.
+//
+// The async thread writes the slot after the last decoded frame while the main
+// thread uploads the first one; the ring is never full when a decode is running
+// so the two slots never overlap.
+class AnimatedImageDecoder
+{
+  public:
+    struct Frame
+    {
+        std::vector<stbi_uc> pixels;
+        int delay = 0; // ms
+    };
+
+    std::atomic<bool> cancelled { false };
+
+    explicit AnimatedImageDecoder(const ByteBuffer& data)
+        : data(data)
+    {
+        this->restart();
+    }
+
+    ~AnimatedImageDecoder()
+    {
+        this->freeCanvas();
+    }
+
+    /**
+     * Reads the size of the animation, returns false if the data is not a GIF.
+     * Must be called once, before the first decodeFrame().
+     */
+    bool readInfo(int* width, int* height)
+    {
+        int comp;
+        if (!stbi_info_from_memory(this->data.data(), (int)this->data.size(), width, height, &comp))
+            return false;
+
+        this->width  = *width;
+        this->height = *height;
+        return this->width > 0 && this->height > 0;
+    }
+
+    /**
+     * Returns true if a frame should be decoded, in which case the caller
+     * must run decodeFrame() on the async thread.
+     */
+    bool startDecoding()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (this->decoding || this->finished || this->count == FRAME_RING_SIZE)
+            return false;
+
+        this->decoding = true;
+        return true;
+    }
+
+    void decodeFrame()
+    {
+        size_t slot;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            slot = (this->readIndex + this->count) % FRAME_RING_SIZE;
+        }
+
+        bool decoded = !this->cancelled && this->decodeNext(&this->ring[slot]);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->decoding = false;
+
+        if (decoded)
+            this->count++;
+        else
+            this->finished = true;
+    }
+
+    /**
+     * Returns the next frame to display, or nullptr if it is not decoded yet.
+     */
+    Frame* front()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->count > 0 ? &this->ring[this->readIndex] : nullptr;
+    }
+
+    void popFront()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->readIndex = (this->readIndex + 1) % FRAME_RING_SIZE;
+        this->count--;
+    }
+
+  private:
+    ByteBuffer data;
+    int width  = 0;
+    int height = 0;
+
+    stbi__context context;
+    stbi__gif gif;
+
+    // Canvas of the two previous frames, for the "restore to previous" disposal
+    std::vector<stbi_uc> previous;
+    std::vector<stbi_uc> beforePrevious;
+
+    size_t framesInLoop = 0;
+
+    std::mutex mutex;
+    std::array<Frame, FRAME_RING_SIZE> ring;
+    size_t readIndex = 0;
+    size_t count     = 0;
+    bool decoding    = false;
+    bool finished    = false;
+
+    void freeCanvas()
+    {
+        STBI_FREE(this->gif.out);
+        STBI_FREE(this->gif.background);
+        STBI_FREE(this->gif.history);
+    }
+
+    void restart()
+    {
+        this->freeCanvas();
+        memset(&this->gif, 0, sizeof(this->gif));
+        stbi__start_mem(&this->context, this->data.data(), (int)this->data.size());
+
+        this->previous.clear();
+        this->beforePrevious.clear();
+        this->framesInLoop = 0;
+    }
+
+    bool decodeNext(Frame* frame)
+    {
+        int comp;
+        stbi_uc* twoBack = this->beforePrevious.empty() ? nullptr : this->beforePrevious.data();
+        stbi_uc* canvas  = stbi__gif_load_next(&this->context, &this->gif, &comp, 4, twoBack);
+
+        // End of the animation, loop unless it is a still image
+        if (canvas == (stbi_uc*)&this->context)
+        {
+            if (this->framesInLoop <= 1)
+                return false;
+
+            this->restart();
+            canvas = stbi__gif_load_next(&this->context, &this->gif, &comp, 4, nullptr);
+        }
+
+        if (!canvas || canvas == (stbi_uc*)&this->context)
+        {
+            Logger::error("Cannot decode GIF frame: {}", stbi_failure_reason());
+            return false;
+        }
+
+        size_t size = (size_t)this->width * this->height * 4;
+
+        this->beforePrevious.swap(this->previous);
+        this->previous.assign(canvas, canvas + size);
+        this->framesInLoop++;
+
+        frame->pixels.assign(canvas, canvas + size);
+        frame->delay = this->gif.delay < MIN_FRAME_DELAY ? DEFAULT_FRAME_DELAY : this->gif.delay;
+        return true;
+    }
+};
+
+AnimatedImage::AnimatedImage()
+{
+    // Replace the Image attribute to load animations
+    this->registerFilePathXMLAttribute("image", [this](const std::string& value)
+        { this->setImageFromFile(value); });
+
+    // Checked every frame, only started while there is an animation to play
+    this->playbackTimer.setPeriod(0);
+    this->playbackTimer.setCallback([this]
+        { this->checkNextFrame(); });
+}
+
+void AnimatedImage::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+{
+    // Frames only advance while the view is drawn: culled and hidden animations are paused
+    if (this->decoder && this->playing)
+    {
+        this->showNextFrame(vg);
+        this->playbackTimer.start();
+    }
+
+    Image::draw(vg, x, y, width, height, style, ctx);
+}
+
+void AnimatedImage::showNextFrame(NVGcontext* vg)
+{
+    Time now = FrameClock::getFrameTime();
+
+    AnimatedImageDecoder::Frame* frame = this->decoder->front();
+    if (frame && this->isNextFrameDue())
+    {
+        if (this->texture == 0)
+        {
+            this->setFreeTexture(true);
+            // Mip levels are not updated with the frames
+            int flags = this->getImageFlags() & ~NVG_IMAGE_GENERATE_MIPMAPS;
+            this->innerSetImage(nvgCreateImageRGBA(vg, this->animationWidth, this->animationHeight, flags, frame->pixels.data()));
+            this->invalidateImageBounds();
+        }
+        else
+        {
+            nvgUpdateImage(vg, this->texture, frame->pixels.data());
+        }
+
+        // Start over from now if the animation was paused or not drawn for a while
+        Time delay        = (Time)frame->delay * 1000;
+        this->nextFrameAt = this->nextFrameAt + delay < now ? now + delay : this->nextFrameAt + delay;
+
+        this->decoder->popFront();
+    }
+
+    this->requestFrame();
+}
+
+bool AnimatedImage::isNextFrameDue()
+{
+    return this->texture == 0 || FrameClock::getFrameTime() >= this->nextFrameAt;
+}
+
+void AnimatedImage::checkNextFrame()
+{
+    if (!this->decoder || !this->isNextFrameDue() || !this->decoder->front())
+        return;
+
+    // The due frame was invalidated but not drawn since: the view is culled,
+    // wait for the next draw instead of checking every frame
+    if (this->invalidatedFrameAt == this->nextFrameAt)
+    {
+        this->playbackTimer.stop();
+        return;
+    }
+
+    this->invalidatedFrameAt = this->nextFrameAt;
+    this->invalidateLayer();
+}
+
+void AnimatedImage::requestFrame()
+{
+    if (!this->decoder->startDecoding())
+        return;
+
+    std::shared_ptr<AnimatedImageDecoder> decoder = this->decoder;
+    brls::async([decoder]()
+        { decoder->decodeFrame(); });
+}
+
+bool AnimatedImage::setAnimation(const ByteBuffer& data)
+{
+    auto decoder = std::make_shared<AnimatedImageDecoder>(data);
+
+    // Read once here, the decoder is not touched from the main thread while a frame is being decoded
+    int width, height;
+    if (!decoder->readInfo(&width, &height))
+        return false;
+
+    this->clear();
+
+    this->decoder            = decoder;
+    this->animationWidth     = width;
+    this->animationHeight    = height;
+    this->nextFrameAt        = 0;
+    this->invalidatedFrameAt = -1;
+
+    if (this->playing)
+        this->playbackTimer.start();
+
+    // Decode the first frame right away, it is uploaded on the next draw
+    this->requestFrame();
+    return true;
+}
+
+void AnimatedImage::setImageFromRes(const std::string& name)
+{
+    this->setImageFromMem(ByteBuffer::fromRes(name));
+}
+
+void AnimatedImage::setImageFromFile(const std::string& path)
+{
+#ifdef USE_LIBROMFS
+    if (path.rfind("@res/", 0) == 0)
+        return this->setImageFromRes(path.substr(5));
+#endif
+
+    ByteBuffer data = ByteBuffer::fromFile(path);
+    if (data.empty())
+        return;
+
+    if (!this->setAnimation(data))
+    {
+        this->clear();
+        Image::setImageFromFile(path);
+    }
+}
+
+void AnimatedImage::setImageFromMem(const unsigned char* data, int size)
+{
+    // The frames are decoded after this returns, keep a copy of the data
+    this->setImageFromMem(ByteBuffer::copy(data, size));
+}
+
+void AnimatedImage::setImageFromMem(const ByteBuffer& data)
+{
+    if (!this->setAnimation(data))
+    {
+        this->clear();
+        Image::setImageFromMem(data);
+    }
+}
+
+void AnimatedImage::clear()
+{
+    this->stopDecoder();
+
+    // Static images may come from the texture cache
+    if (this->texture != 0 && !this->freeTexture)
+    {
+        TextureCache::instance().removeCache(this->texture);
+        this->texture = 0;
+    }
+
+    Image::clear();
+}
+
+void AnimatedImage::stopDecoder()
+{
+    if (!this->decoder)
+        return;
+
+    this->decoder->cancelled = true;
+    this->decoder.reset();
+    this->playbackTimer.stop();
+}
+
+void AnimatedImage::willAppear(bool resetState)
+{
+    Image::willAppear(resetState);
+
+    if (this->decoder && this->playing)
+        this->playbackTimer.start();
+}
+
+void AnimatedImage::willDisappear(bool resetState)
+{
+    Image::willDisappear(resetState);
+    this->playbackTimer.stop();
+}
+
+void AnimatedImage::play()
+{
+    this->playing = true;
+
+    if (this->decoder)
+        this->playbackTimer.start();
+}
+
+void AnimatedImage::pause()
+{
+    this->playing = false;
+    this->playbackTimer.stop();
+}
+
+bool AnimatedImage::isPlaying()
+{
+    return this->playing;
+}
+
+AnimatedImage::~AnimatedImage()
+{
+    this->stopDecoder();
+}
+
+View* AnimatedImage::create()
+{
+    return new AnimatedImage();
+}
+
+} // namespace brls
@@ -95,12 +95,27 @@ BottomBar::BottomBar()
     Platform* platform = Application::getPlatform();
     battery->setVisibility(platform->canShowBatteryLevel() ? Visibility::VISIBLE : Visibility::GONE);
     wireless->setVisibility(platform->canShowWirelessLevel() ? Visibility::VISIBLE : Visibility::GONE);
+
+    // The label is only changed when the displayed second changes
+    this->updateText();
+    this->clockTimer.setPeriod(200);
+    this->clockTimer.setCallback([this]
+        { this->updateText(); });
 }
 
-void BottomBar::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+void BottomBar::willAppear(bool resetState)
 {
+    Box::willAppear(resetState);
+
+    // The clock only ticks while the bar is shown
     this->updateText();
-    Box::draw(vg, x, y, width, height, style, ctx);
+    this->clockTimer.start();
+}
+
+void BottomBar::willDisappear(bool resetState)
+{
+    Box::willDisappear(resetState);
+    this->clockTimer.stop();
 }
 
 void BottomBar::updateText()
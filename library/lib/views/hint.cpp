@@ -21,6 +21,7 @@
 #include <borealis/core/util.hpp>
 #include <borealis/views/applet_frame.hpp>
 #include <borealis/views/hint.hpp>
+#include <bitset>
 
 using namespace brls::literals;
 
@@ -53,28 +54,56 @@ const std::string hintXML = R"xml(
     </brls:Box>
 )xml";
 
-Hint::Hint(Action action, bool allowAButtonTouch)
+Hint::Hint(const Action& action, bool allowAButtonTouch)
     : Box(Axis::ROW)
     , action(action)
 {
     this->inflateFromXMLString(hintXML);
     this->setFocusable(false);
 
-    icon->setText(getKeyIcon(action.button));
-    hint->setText(action.hintText);
+    this->iconColor = icon->getTextColor();
+    this->hintColor = hint->getTextColor();
 
-    if ((action.button != BUTTON_A || allowAButtonTouch) && action.available && !Application::isInputBlocks())
+    this->setAction(action, allowAButtonTouch);
+}
+
+void Hint::setAction(const Action& action, bool allowAButtonTouch)
+{
+    bool enabled = action.available && !Application::isInputBlocks();
+
+    // The icon also depends on the keys swap, compare the resolved one
+    std::string keyIcon = getKeyIcon(action.button);
+    if (keyIcon != icon->getFullText())
+        icon->setText(keyIcon);
+
+    if (action.hintText != hint->getFullText())
+        hint->setText(action.hintText);
+
+    if (enabled != this->enabled)
     {
-        this->addGestureRecognizer(new TapGestureRecognizer(this, [this, action]()
-            { action.actionListener(this); }));
+        Theme theme = Application::getTheme();
+        icon->setTextColor(enabled ? this->iconColor : theme["brls/text_disabled"]);
+        hint->setTextColor(enabled ? this->hintColor : theme["brls/text_disabled"]);
     }
 
-    if (!action.available || Application::isInputBlocks())
+    // Always copied, the listener of an unchanged looking action can belong to another view
+    this->action   = action;
+    this->enabled  = enabled;
+    this->tappable = (action.button != BUTTON_A || allowAButtonTouch) && enabled;
+
+    // The recognizer is only attached once the hint is tappable, then disabled
+    // when it is not. The action can change when the hint is reused, it is read when tapped.
+    if (this->tappable && !this->tapRecognizer)
     {
-        Theme theme = Application::getTheme();
-        icon->setTextColor(theme["brls/text_disabled"]);
-        hint->setTextColor(theme["brls/text_disabled"]);
+        this->tapRecognizer = new TapGestureRecognizer(this, [this]()
+            {
+                if (this->action.actionListener)
+                    this->action.actionListener(this); });
+        this->addGestureRecognizer(this->tapRecognizer);
     }
+
+    if (this->tapRecognizer)
+        this->tapRecognizer->setEnabled(this->tappable);
 }
 
 std::string Hint::getKeyIcon(ControllerButton button, bool ignoreKeysSwap)
@@ -141,6 +170,8 @@ Hints::Hints()
 
     this->registerBoolXMLAttribute("forceShown", [this](bool value)
         { this->forceShown = value; });
+
+    this->unableAButtonAction = Action { BUTTON_A, 0, "hints/ok"_i18n, false, false, false, Sound::SOUND_NONE, NULL };
 }
 
 Hints::~Hints()
@@ -153,42 +184,44 @@ void Hints::refillHints(View* focusView)
     if (!focusView)
         return;
 
-    // todo: 做一个缓存，可以节约 Hint 组件生成
-    clearViews();
-
-    std::set<ControllerButton> addedButtons; // we only ever want one action per key
-    std::vector<Action> actions;
+    std::bitset<_BUTTON_MAX> addedButtons; // we only ever want one action per key
+    this->actions.clear();
 
     while (focusView != nullptr)
     {
-        for (auto& action : focusView->getActions())
+        for (const Action& action : focusView->getActions())
         {
             if (action.hidden)
                 continue;
 
-            if (addedButtons.find(action.button) != addedButtons.end())
+            if (addedButtons[action.button])
                 continue;
 
-            addedButtons.insert(action.button);
-            actions.push_back(action);
+            addedButtons[action.button] = true;
+            this->actions.push_back(&action);
         }
 
         focusView = focusView->getParent();
     }
 
-    if (addUnableAButtonAction && std::find(actions.begin(), actions.end(), BUTTON_A) == actions.end())
-    {
-        actions.push_back(Action { BUTTON_A, 0, "hints/ok"_i18n, false, false, false, Sound::SOUND_NONE, NULL });
-    }
+    if (addUnableAButtonAction && !addedButtons[BUTTON_A])
+        this->actions.push_back(&this->unableAButtonAction);
 
     // Sort the actions
-    std::stable_sort(actions.begin(), actions.end(), Hints::actionsSortFunc);
+    std::stable_sort(this->actions.begin(), this->actions.end(), Hints::actionsSortFunc);
 
-    for (Action action : actions)
-    {
-        Hint* hint = new Hint(action, allowAButtonTouch);
-        addView(hint);
-    }
+    // Existing hint views are reused, their labels are only updated if they show another action
+    const std::vector<View*>& hintViews = this->getChildren();
+    size_t reused                       = std::min(hintViews.size(), this->actions.size());
+
+    for (size_t i = 0; i < reused; i++)
+        ((Hint*)hintViews[i])->setAction(*this->actions[i], allowAButtonTouch);
+
+    while (this->getChildren().size() > this->actions.size())
+        this->removeView(this->getChildren().back());
+
+    for (size_t i = reused; i < this->actions.size(); i++)
+        this->addView(new Hint(*this->actions[i], allowAButtonTouch));
 }
 
 int buttonToSortableVal(ControllerButton button) {
@@ -209,9 +242,9 @@ int buttonToSortableVal(ControllerButton button) {
     }
 }
 
-bool Hints::actionsSortFunc(Action a, Action b)
+bool Hints::actionsSortFunc(const Action* a, const Action* b)
 {
-    return buttonToSortableVal(a.button) < buttonToSortableVal(b.button);
+    return buttonToSortableVal(a->button) < buttonToSortableVal(b->button);
 }
 
 View* Hints::create()
@@ -16,6 +16,8 @@
     limitations under the License.
 */
 
+#include <stb_image.h>
+
 #include <borealis/core/application.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/image.hpp>
@@ -26,6 +28,48 @@
 namespace brls
 {
 
+// AUTO interpolation generates mipmaps below this drawing scale
+static const float MIPMAP_SCALE_THRESHOLD = 0.5f;
+
+// The image flags nanovg applies to a texture of the given size
+static int getAppliedImageFlags(int flags, int width, int height)
+{
+#if defined(BOREALIS_USE_OPENGL) && !defined(USE_GL2) && (defined(__PSV__) || defined(USE_GLES2))
+    // OpenGL ES 2 has no mipmaps for non power of two textures
+    if ((width & (width - 1)) != 0 || (height & (height - 1)) != 0)
+        flags &= ~NVG_IMAGE_GENERATE_MIPMAPS;
+#endif
+    return flags;
+}
+
+// Decodes an image file with the same options as nvgCreateImage()
+static unsigned char* decodeFile(const std::string& path, int* width, int* height)
+{
+    int comp;
+    stbi_set_unpremultiply_on_load(1);
+    stbi_convert_iphone_png_to_rgb(1);
+    unsigned char* pixels = stbi_load(path.c_str(), width, height, &comp, 4);
+
+    if (!pixels)
+        Logger::error("Failed to load image {}: {}", path, stbi_failure_reason());
+
+    return pixels;
+}
+
+// Decodes an image in memory with the same options as nvgCreateImageMem()
+static unsigned char* decodeMemory(const unsigned char* data, int size, int* width, int* height)
+{
+    int comp;
+    stbi_set_unpremultiply_on_load(1);
+    stbi_convert_iphone_png_to_rgb(1);
+    unsigned char* pixels = stbi_load_from_memory(data, size, width, height, &comp, 4);
+
+    if (!pixels)
+        Logger::error("Failed to load image: {}", stbi_failure_reason());
+
+    return pixels;
+}
+
 static float measureWidth(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode, float originalWidth, ImageScalingType type)
 {
     if (widthMode == YGMeasureModeUndefined)
@@ -73,7 +117,7 @@ static YGSize imageMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
         .height = height,
     };
 
-    if (texture == 0)
+    if (texture == 0 && !image->isDecodePending())
         return size;
 
     // Stretched mode: we don't care about the size of the image
@@ -160,6 +204,8 @@ Image::Image()
         {
             { "linear", ImageInterpolation::LINEAR },
             { "nearest", ImageInterpolation::NEAREST },
+            { "trilinear", ImageInterpolation::TRILINEAR },
+            { "auto", ImageInterpolation::AUTO },
         });
 
     this->registerFilePathXMLAttribute("image", [this](const std::string& value)
@@ -197,6 +243,37 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
 void Image::onLayout()
 {
     this->invalidateImageBounds();
+
+    // Layout events are fired while the tree is being laid out, decode or reload on the next frame
+    if (!this->pendingAutoPath.empty() && this->getWidth() > 0 && this->getHeight() > 0)
+    {
+        ASYNC_RETAIN
+        brls::sync([ASYNC_TOKEN]()
+            {
+            ASYNC_RELEASE
+            this->checkAutoInterpolation(); });
+    }
+}
+
+void Image::checkAutoInterpolation()
+{
+    std::string path = std::move(this->pendingAutoPath);
+    this->pendingAutoPath.clear();
+
+    if (path.empty())
+        return;
+
+    // Only the size was read, the image is decoded now that the drawing scale is known
+    if (this->decodePending)
+        return this->setImageFromFile(path);
+
+    if (this->texture == 0 || this->interpolation != ImageInterpolation::AUTO)
+        return;
+
+    // The image was taken from the cache before the view size was known
+    int flags = this->getImageFlags((int)this->originalImageWidth, (int)this->originalImageHeight);
+    if ((flags & NVG_IMAGE_GENERATE_MIPMAPS) && !TextureCache::instance().hasMipmaps(this->texture))
+        this->setImageFromFile(path);
 }
 
 void Image::setImageAlign(ImageAlignment align)
@@ -277,21 +354,66 @@ void Image::invalidateImageBounds()
 
 size_t Image::checkCache(const std::string& path)
 {
+    TextureCache& cache = TextureCache::instance();
+
     if (this->texture > 0)
     {
-        brls::TextureCache::instance().removeCache(this->texture);
+        cache.removeCache(this->texture);
         brls::Logger::verbose("cache remove: {} {}", path, this->texture);
     }
 
-    int tex = brls::TextureCache::instance().getCache(path);
-    if (tex > 0)
+    int tex = cache.getCache(path);
+    if (tex <= 0)
+        return 0;
+
+    // The cached texture has the size of the source image
+    int width = 0, height = 0;
+    nvgImageSize(Application::getNVGContext(), tex, &width, &height);
+
+    // A texture without mipmaps cannot be drawn with them: it is replaced by a mipmapped one
+    // under the same key, and deleted once the images still using it release it
+    if ((this->getImageFlags(width, height) & NVG_IMAGE_GENERATE_MIPMAPS) && !cache.hasMipmaps(tex))
     {
-        brls::Logger::verbose("cache hit: {} {}", path, tex);
-        this->innerSetImage(tex);
-        return tex;
+        brls::Logger::verbose("cache miss (no mipmaps): {} {}", path, tex);
+        cache.removeCache(tex);
+        cache.markDirty(tex);
+        return 0;
     }
 
-    return 0;
+    brls::Logger::verbose("cache hit: {} {}", path, tex);
+    this->innerSetImage(tex);
+    return tex;
+}
+
+bool Image::isWaitingForLayout()
+{
+    return this->interpolation == ImageInterpolation::AUTO && !(this->getWidth() > 0 && this->getHeight() > 0);
+}
+
+void Image::deferDecode(int sourceWidth, int sourceHeight)
+{
+    // The previous texture was released from the cache by checkCache()
+    this->texture             = 0;
+    this->decodePending       = true;
+    this->originalImageWidth  = (float)sourceWidth;
+    this->originalImageHeight = (float)sourceHeight;
+
+    this->invalidate();
+}
+
+int Image::createTexture(unsigned char* pixels, int width, int height, bool* mipmaps)
+{
+    if (!pixels)
+        return 0;
+
+    int flags = this->getImageFlags(width, height);
+    int tex   = nvgCreateImageRGBA(Application::getNVGContext(), width, height, flags, pixels);
+    stbi_image_free(pixels);
+
+    if (mipmaps)
+        *mipmaps = flags & NVG_IMAGE_GENERATE_MIPMAPS;
+
+    return tex;
 }
 
 void Image::setImageFromRes(const std::string& path)
@@ -300,11 +422,26 @@ void Image::setImageFromRes(const std::string& path)
     this->setFreeTexture(false);
 
 #ifdef USE_LIBROMFS
-    if (checkCache("@res/" + path) > 0)
+    std::string key = "@res/" + path;
+
+    this->pendingAutoPath = key;
+
+    if (checkCache(key) > 0)
+        return;
+
+    ByteBuffer data = ByteBuffer::fromRes(path);
+    if (data.empty())
         return;
-    auto image = romfs::get(path);
-    this->setImageFromMem((unsigned char*)image.data(), (int)image.size());
-    TextureCache::instance().addCache("@res/" + path, this->texture);
+
+    // AUTO needs the drawing scale, only the size is read until the view is laid out
+    int width, height, comp;
+    if (this->isWaitingForLayout() && stbi_info_from_memory(data.data(), (int)data.size(), &width, &height, &comp))
+        return this->deferDecode(width, height);
+
+    bool mipmaps          = false;
+    unsigned char* pixels = decodeMemory(data.data(), (int)data.size(), &width, &height);
+    this->innerSetImage(this->createTexture(pixels, width, height, &mipmaps));
+    TextureCache::instance().addCache(key, this->texture, mipmaps);
 #else
     this->setImageFromFile(std::string(BRLS_RESOURCES) + path);
 #endif
@@ -315,12 +452,50 @@ void Image::setInterpolation(ImageInterpolation interpolation)
     this->interpolation = interpolation;
 }
 
-int Image::getImageFlags()
+int Image::getImageFlags(int sourceWidth, int sourceHeight)
 {
-    if (this->interpolation == ImageInterpolation::NEAREST)
-        return NVG_IMAGE_NEAREST;
+    switch (this->interpolation)
+    {
+        case ImageInterpolation::NEAREST:
+            return NVG_IMAGE_NEAREST;
+        case ImageInterpolation::TRILINEAR:
+            return getAppliedImageFlags(NVG_IMAGE_GENERATE_MIPMAPS, sourceWidth, sourceHeight);
+        case ImageInterpolation::AUTO:
+            if (this->getDrawScale(sourceWidth, sourceHeight) < MIPMAP_SCALE_THRESHOLD)
+                return getAppliedImageFlags(NVG_IMAGE_GENERATE_MIPMAPS, sourceWidth, sourceHeight);
+            return 0;
+        default:
+            return 0;
+    }
+}
 
-    return 0;
+float Image::getDrawScale(int sourceWidth, int sourceHeight)
+{
+    float width  = this->getWidth();
+    float height = this->getHeight();
+
+    // Unknown sizes, assume the image is drawn at its size
+    if (sourceWidth <= 0 || sourceHeight <= 0 || !(width > 0) || !(height > 0))
+        return 1.0f;
+
+    float scaleX = width / sourceWidth;
+    float scaleY = height / sourceHeight;
+    float scale;
+
+    switch (this->scalingType)
+    {
+        case ImageScalingType::FILL:
+            scale = std::max(scaleX, scaleY);
+            break;
+        case ImageScalingType::CENTER:
+            return 1.0f;
+        default: // FIT and STRETCH, the most reduced axis decides
+            scale = std::min(scaleX, scaleY);
+            break;
+    }
+
+    // In pixels, the window can be scaled up or down
+    return scale * Application::windowScale * Application::getPlatform()->getVideoContext()->getScaleFactor();
 }
 
 void Image::setImageFromFile(const std::string& path)
@@ -332,35 +507,62 @@ void Image::setImageFromFile(const std::string& path)
     if (path.rfind("@res/", 0) == 0)
         return this->setImageFromRes(path.substr(5));
 #endif
+    this->pendingAutoPath = path;
+
     if (checkCache(path) > 0)
         return;
 
+    // AUTO needs the drawing scale, only the size is read until the view is laid out
+    int width, height, comp;
+    if (this->isWaitingForLayout() && stbi_info(path.c_str(), &width, &height, &comp))
+        return this->deferDecode(width, height);
+
     // Load texture
-    int tex = nvgCreateImage(Application::getNVGContext(), path.c_str(), this->getImageFlags());
+    bool mipmaps          = false;
+    unsigned char* pixels = decodeFile(path, &width, &height);
+    int tex               = this->createTexture(pixels, width, height, &mipmaps);
     innerSetImage(tex);
 
     // Save cache
-    TextureCache::instance().addCache(path, tex);
+    TextureCache::instance().addCache(path, tex, mipmaps);
 }
 
 void Image::setImageFromMem(const unsigned char* data, int size)
 {
-    NVGcontext* vg = Application::getNVGContext();
+    this->pendingAutoPath.clear();
+
+    int width, height;
+    unsigned char* pixels = decodeMemory(data, size, &width, &height);
 
     // Load texture
-    innerSetImage(nvgCreateImageMem(vg, 0, const_cast<unsigned char*>(data), size));
+    innerSetImage(this->createTexture(pixels, width, height, nullptr));
 }
 
-void Image::setImageAsync(std::function<void(std::function<void(const std::string&, size_t length)>)> cb)
+void Image::setImageFromMem(const ByteBuffer& data)
+{
+    if (data.empty())
+        return;
+
+    Image::setImageFromMem(data.data(), (int)data.size());
+}
+
+void Image::setImageAsync(std::function<void(std::function<void(ByteBuffer)>)> cb)
 {
     ASYNC_RETAIN
-    cb([ASYNC_TOKEN](const std::string& data, size_t length)
-        { brls::sync([ASYNC_TOKEN, data, length]()
+    cb([ASYNC_TOKEN](ByteBuffer data)
+        { brls::sync([ASYNC_TOKEN, data = std::move(data)]()
               {
             ASYNC_RELEASE
-            if(length == 0)
+            if(data.empty())
                 return;
-            this->setImageFromMem((unsigned char *) data.c_str(),(int) length); }); });
+            this->setImageFromMem(data); }); });
+}
+
+void Image::setImageAsync(std::function<void(std::function<void(const std::string&, size_t length)>)> cb)
+{
+    this->setImageAsync([cb](std::function<void(ByteBuffer)> setData)
+        { cb([setData](const std::string& data, size_t length)
+              { setData(ByteBuffer::copy(data.data(), length)); }); });
 }
 
 void Image::innerSetImage(int tex)
@@ -378,7 +580,8 @@ void Image::innerSetImage(int tex)
         nvgDeleteImage(vg, this->texture);
 
     // Set the new texture
-    this->texture = tex;
+    this->texture       = tex;
+    this->decodePending = false;
 
     int width, height;
     nvgImageSize(vg, this->texture, &width, &height);
@@ -390,6 +593,9 @@ void Image::innerSetImage(int tex)
 
 void Image::clear()
 {
+    this->pendingAutoPath.clear();
+    this->decodePending = false;
+
     if (this->texture == 0)
         return;
 
@@ -421,6 +627,11 @@ int Image::getTexture()
     return this->texture;
 }
 
+bool Image::isDecodePending()
+{
+    return this->decodePending;
+}
+
 void Image::setFreeTexture(bool value)
 {
     this->freeTexture = value;
@@ -15,16 +15,19 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/label.hpp>
+#include <cmath>
 
 namespace brls
 {
 
 #define ELLIPSIS "\u2026"
+#define CURSOR_BLINK_PERIOD 500
 
 static size_t strLen(const std::string& str)
 {
@@ -200,7 +203,14 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
 
 void Label::setCursor(int cursor) {
     this->cursor = cursor;
-    this->cursor_blink = brls::getCPUTimeUsec();
+
+    // The cursor is shown right after moving, the timer only runs while there is one to blink
+    this->cursorVisible = true;
+    this->cursorTimer.stop();
+    if (cursor >= (int)CursorPosition::END)
+        this->cursorTimer.start();
+
+    this->invalidateLayer();
 }
 
 Label::Label()
@@ -217,6 +227,13 @@ Label::Label()
 
     this->setHighlightPadding(style["brls/label/highlight_padding"]);
 
+    // Only redrawn when the cursor blinks
+    this->cursorTimer.setPeriod(CURSOR_BLINK_PERIOD);
+    this->cursorTimer.setCallback([this]
+        {
+            this->cursorVisible = !this->cursorVisible;
+            this->invalidateLayer(); });
+
     // Setup the custom measure function
     YGNodeSetMeasureFunc(this->ygNode, labelMeasureFunc);
 
@@ -331,6 +348,7 @@ void Label::onParentFocusLost(View* focusedView)
 void Label::setTextColor(NVGcolor color)
 {
     this->textColor = color;
+    this->invalidateLayer();
 }
 
 std::string Label::STConverter(const std::string& text)
@@ -347,6 +365,9 @@ std::string Label::STConverter(const std::string& text)
 
 void Label::setText(const std::string& text)
 {
+    // The glyphs point into the previous text
+    this->scrollingGlyphs.clear();
+
 #ifdef OPENCC
     static bool trans = Application::getLocale() == LOCALE_ZH_HANT || Application::getLocale() == LOCALE_ZH_TW;
     if (trans && OPENCC_ON)
@@ -381,6 +402,7 @@ void Label::setSingleLine(bool singleLine)
 void Label::setFontSize(float value)
 {
     this->fontSize = value;
+    this->scrollingGlyphs.clear();
 
     this->invalidate();
 }
@@ -388,6 +410,7 @@ void Label::setFontSize(float value)
 void Label::setFontQuality(float value)
 {
     this->fontQuality = value;
+    this->scrollingGlyphs.clear();
 
     this->invalidate();
 }
@@ -461,13 +484,24 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         float scissorHeight = fontSize * lineHeight;
         nvgIntersectScissor(vg, x, y, width, scissorHeight < height ? height : scissorHeight);
 
-        float baseX   = x - this->scrollingAnimation;
+        // The glyph positions are measured from the left
+        nvgTextAlign(vg, NVG_ALIGN_LEFT | vertAlign);
+
+        if (this->scrollingGlyphs.empty() && !this->fullText.empty())
+        {
+            this->scrollingGlyphs.resize(this->stringLength);
+            int count = nvgTextGlyphPositions(vg, 0, 0, this->fullText.c_str(), nullptr, this->scrollingGlyphs.data(), (int)this->stringLength);
+            this->scrollingGlyphs.resize(count);
+        }
+
+        float offset  = this->getScrollingOffset(style);
+        float baseX   = x - offset;
         float spacing = style["brls/label/scrolling_animation_spacing"];
 
-        nvgText(vg, baseX, y + height / 2.0f, this->fullText.c_str(), nullptr);
+        this->drawScrollingText(vg, baseX, y + height / 2.0f, x, x + width);
 
-        if (this->scrollingAnimation > 0)
-            nvgText(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, this->fullText.c_str(), nullptr);
+        if (offset > 0)
+            this->drawScrollingText(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, x, x + width);
 
         nvgRestore(vg);
     }
@@ -498,8 +532,7 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         // 绘制编辑游标
         if (this->cursor >= (int)CursorPosition::END) {
             // blink
-            auto blink = ((brls::getCPUTimeUsec() - cursor_blink) >> 10) % 1000 ;
-            if (blink > 500)
+            if (!this->cursorVisible)
                 return;
 
             nvgSave(vg);
@@ -531,61 +564,108 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
     }
 }
 
-void Label::stopScrollingAnimation()
+void Label::drawScrollingText(NVGcontext* vg, float textX, float textY, float minX, float maxX)
 {
-    // Extra check to avoid stopping inexisting timers on labels that
-    // are never animated
-    if (!this->animating)
+    const std::vector<NVGglyphPosition>& glyphs = this->scrollingGlyphs;
+    if (glyphs.empty())
         return;
 
-    this->scrollingTimer.stop();
-    this->scrollingTimer.reset();
+    // First glyph ending after minX, first glyph starting after maxX
+    auto first = std::partition_point(glyphs.begin(), glyphs.end(), [textX, minX](const NVGglyphPosition& glyph)
+        { return textX + glyph.maxx <= minX; });
+    auto last = std::partition_point(first, glyphs.end(), [textX, maxX](const NVGglyphPosition& glyph)
+        { return textX + glyph.minx < maxX; });
 
-    this->scrollingAnimation = 0.0f;
+    if (first == last)
+        return;
 
-    this->animating = false;
+    const char* end = last == glyphs.end() ? nullptr : last->str;
+    nvgText(vg, textX + first->x, textY, first->str, end);
 }
 
-void Label::onScrollTimerFinished()
+// Advances the scrolling labels every frame, and invalidates their layers so that
+// they keep scrolling inside cached layers. Stops once no label is scrolling anymore.
+class MarqueeTicking : public Ticking
 {
-    Style style = Application::getStyle();
+  public:
+    static MarqueeTicking* instance()
+    {
+        // Never deleted, labels can be destroyed after the static objects
+        static MarqueeTicking* ticking = new MarqueeTicking();
+        return ticking;
+    }
 
-    // Step 2: actual scrolling animation
-    float target   = this->requiredWidth + style["brls/label/scrolling_animation_spacing"];
-    float duration = target / style["brls/animations/label_scrolling_speed"];
+    void add(Label* label)
+    {
+        this->labels.push_back(label);
+        this->start();
+    }
 
-    this->scrollingAnimation.reset();
+    void remove(Label* label)
+    {
+        auto it = std::find(this->labels.begin(), this->labels.end(), label);
+        if (it == this->labels.end())
+            return;
 
-    this->scrollingAnimation.addStep(target, duration, EasingFunction::linear);
+        *it = this->labels.back();
+        this->labels.pop_back();
+    }
 
-    this->scrollingAnimation.setEndCallback([this](bool finished)
+  protected:
+    bool onUpdate(Time delta) override
+    {
+        for (Label* label : this->labels)
         {
-        // Start over if the scrolling animation ended naturally
-        if (finished)
-            this->startScrollTimer(); });
+            label->scrollingElapsed += delta;
+            label->invalidateLayer();
+        }
+
+        return !this->labels.empty();
+    }
 
-    this->scrollingAnimation.start();
+  private:
+    std::vector<Label*> labels;
+};
 
-    this->animating = true;
+void Label::stopScrollingAnimation()
+{
+    // Extra check to avoid looking for labels that are never animated
+    if (!this->animating)
+        return;
+
+    MarqueeTicking::instance()->remove(this);
+
+    this->scrollingGlyphs.clear();
+
+    this->animating = false;
 }
 
 void Label::startScrollTimer()
 {
-    Style style = Application::getStyle();
+    if (!this->animating)
+        MarqueeTicking::instance()->add(this);
 
-    // Step 1: timer before starting to scroll
-    this->scrollingAnimation = 0.0f;
+    this->scrollingElapsed = 0;
 
-    this->scrollingTimer.reset();
+    this->animating = true;
+}
 
-    this->scrollingTimer.setDuration(style["brls/animations/label_scrolling_timer"]);
+float Label::getScrollingOffset(Style style)
+{
+    // Wait, then scroll the whole text and the spacing at a constant speed
+    float timer    = style["brls/animations/label_scrolling_timer"];
+    float target   = this->requiredWidth + style["brls/label/scrolling_animation_spacing"];
+    float duration = target / style["brls/animations/label_scrolling_speed"];
 
-    this->scrollingTimer.setEndCallback([this](bool finished)
-        { this->onScrollTimerFinished(); });
+    float period = timer + duration;
+    if (period <= 0.0f)
+        return 0.0f;
 
-    this->scrollingTimer.start();
+    float elapsed = fmodf((float)this->scrollingElapsed, period);
+    if (elapsed < timer)
+        return 0.0f;
 
-    this->animating = true;
+    return target * (elapsed - timer) / duration;
 }
 
 void Label::resetScrollingAnimation()
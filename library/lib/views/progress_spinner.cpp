@@ -37,6 +37,9 @@ void ProgressSpinner::restartAnimation()
 
     this->animationValue.reset(0);
     this->animationValue.stop();
+    this->animationValue.setTickCallback([this] {
+        this->invalidateLayer();
+    });
     this->animationValue.setEndCallback([this](bool done) {
         if (done)
             this->restartAnimation();
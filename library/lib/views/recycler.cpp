@@ -17,6 +17,7 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/touch/tap_gesture.hpp>
 #include <borealis/views/recycler.hpp>
+#include <algorithm>
 
 namespace brls
 {
@@ -218,6 +219,8 @@ RecyclerFrame::~RecyclerFrame()
 
 void RecyclerFrame::setDataSource(RecyclerDataSource* source, bool deleteDataSource)
 {
+    this->cancelPrefetching();
+
     if (this->dataSource && this->deleteDataSource)
         delete this->dataSource;
 
@@ -237,6 +240,9 @@ void RecyclerFrame::reloadData()
     if (!layouted)
         return;
 
+    // Index paths are about to change
+    this->cancelPrefetching();
+
     auto children = this->contentBox->getChildren();
     for (auto const& child : children)
     {
@@ -269,6 +275,8 @@ void RecyclerFrame::reloadData()
 
         selectRowAt(defaultCellFocus, false);
     }
+
+    this->requestPrefetch();
 }
 
 void RecyclerFrame::registerCell(std::string identifier, std::function<RecyclerCell*()> allocation)
@@ -292,6 +300,9 @@ RecyclerCell* RecyclerFrame::dequeueReusableCell(std::string identifier)
         }
         else
         {
+            Activity* activity = this->getParentActivity();
+            ViewArena::Scope arenaScope(activity ? activity->getArena() : nullptr);
+
             cell                  = allocationMap.at(identifier)();
             cell->reuseIdentifier = identifier;
             cell->detach();
@@ -439,6 +450,73 @@ void RecyclerFrame::cellsRecyclingLoop()
     }
 }
 
+void RecyclerFrame::prefetchRows()
+{
+    // The rows are at most two ranges around the cells, pushed in order
+    // so that both vectors stay sorted without allocating every frame
+    nextPrefetchedRows.clear();
+
+    if (dataSource && prefetchDistance > 0.0f && !contentBox->getChildren().empty())
+    {
+        Rect prefetchFrame = getPrefetchFrame();
+
+        // Rows before the first cell
+        size_t first = visibleMin;
+        float y      = renderedFrame.getMinY() + paddingTop;
+        while (first > 0 && first - 1 < cacheFramesData.size() && y > prefetchFrame.getMinY())
+        {
+            first--;
+            y -= cacheFramesData[first].height;
+        }
+
+        for (size_t i = first; i < visibleMin; i++)
+            nextPrefetchedRows.push_back(i);
+
+        // Rows after the last cell
+        y = renderedFrame.getMaxY() + paddingTop;
+        for (size_t i = visibleMax + 1; i < cacheFramesData.size() && y < prefetchFrame.getMaxY(); i++)
+        {
+            nextPrefetchedRows.push_back(i);
+            y += cacheFramesData[i].height;
+        }
+    }
+
+    for (size_t row : nextPrefetchedRows)
+    {
+        if (!std::binary_search(prefetchedRows.begin(), prefetchedRows.end(), row) && cacheIndexPathData[row].row != -1)
+            dataSource->onPrefetch(this, cacheIndexPathData[row]);
+    }
+
+    // Rows that became cells are not cancelled
+    for (size_t row : prefetchedRows)
+    {
+        if (!std::binary_search(nextPrefetchedRows.begin(), nextPrefetchedRows.end(), row) && (row < visibleMin || row > visibleMax) && row < cacheIndexPathData.size() && cacheIndexPathData[row].row != -1)
+            dataSource->cancelPrefetch(this, cacheIndexPathData[row]);
+    }
+
+    prefetchedRows.swap(nextPrefetchedRows);
+}
+
+void RecyclerFrame::prefetchContent()
+{
+    // Rows are prefetched from the data source instead of the content children
+    this->prefetchRows();
+}
+
+void RecyclerFrame::cancelPrefetching()
+{
+    if (dataSource)
+    {
+        for (size_t row : prefetchedRows)
+        {
+            if (row < cacheIndexPathData.size() && cacheIndexPathData[row].row != -1)
+                dataSource->cancelPrefetch(this, cacheIndexPathData[row]);
+        }
+    }
+
+    prefetchedRows.clear();
+}
+
 void RecyclerFrame::addCellAt(size_t index, size_t downSide)
 {
     IndexPath indexPath = cacheIndexPathData[index];
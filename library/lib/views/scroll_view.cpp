@@ -0,0 +1,1067 @@
+/*
+    Copyright 2020-2021 natinusala
+    Copyright 2021 XITRIX
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/touch/tap_gesture.hpp>
+#include <borealis/views/scroll_view.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace brls
+{
+
+#define SCROLLING_INDICATOR_SIZE 4
+#define SCROLLING_INDICATOR_MARGIN 14
+
+// Flings shorter than that (in ms) are ignored
+#define MIN_FLING_TIME 100
+
+// How far ahead (in seconds of scrolling at the current speed) the prefetch area goes
+#define PREFETCH_VELOCITY_TIME 0.5f
+
+// Smoothing of the scrolling speed, between 0 (none) and 1
+#define VELOCITY_SMOOTHING 0.6f
+
+// Speed of the natural scrolling with the buttons, in px/s
+#define NATURAL_SCROLLING_SPEED 1000.0f
+
+static PanAxis getPanAxis(ScrollAxis axis)
+{
+    switch (axis)
+    {
+        case ScrollAxis::HORIZONTAL:
+            return PanAxis::HORIZONTAL;
+        case ScrollAxis::VERTICAL:
+            return PanAxis::VERTICAL;
+        default:
+            return PanAxis::ANY;
+    }
+}
+
+static bool isHorizontal(FocusDirection direction)
+{
+    return direction == FocusDirection::LEFT || direction == FocusDirection::RIGHT;
+}
+
+ScrollView::ScrollView(ScrollAxis axis)
+    : axis(axis)
+{
+    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
+        "scrollingBehavior", ScrollingBehavior, this->setScrollingBehavior,
+        {
+            { "natural", ScrollingBehavior::NATURAL },
+            { "centered", ScrollingBehavior::CENTERED },
+        });
+
+    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
+        "scrollAxis", ScrollAxis, this->setScrollAxis,
+        {
+            { "horizontal", ScrollAxis::HORIZONTAL },
+            { "vertical", ScrollAxis::VERTICAL },
+            { "both", ScrollAxis::BOTH },
+        });
+
+    this->registerBoolXMLAttribute("snapToItems", [this](bool value)
+        { this->setSnapToItems(value); });
+
+    this->registerFloatXMLAttribute("prefetchDistance", [this](float value)
+        { this->setPrefetchDistance(value); });
+
+    setupScrollingIndicators();
+
+    input = Application::getPlatform()->getInputManager();
+    this->setFocusable(true);
+    this->setMaximumAllowedXMLElements(1);
+
+    this->scrollGesture = new ScrollGestureRecognizer([this](PanGestureStatus state, Sound* soundToPlay) {
+        this->onPanGesture(state);
+    },
+        getPanAxis(axis));
+    addGestureRecognizer(this->scrollGesture);
+
+    // Stop scrolling on tap
+    addGestureRecognizer(new TapGestureRecognizer([this](brls::TapGestureStatus status, Sound* soundToPlay) {
+        if (status.state == GestureState::UNSURE)
+        {
+            this->contentOffsetX.stop();
+            this->contentOffsetY.stop();
+        }
+    }));
+
+    inputTypeSubscription = Application::getGlobalInputTypeChangeEvent()->subscribe([this](InputType type) {
+        if (!focused && !childFocused)
+            return;
+
+        if (behavior == ScrollingBehavior::NATURAL && type == InputType::GAMEPAD)
+        {
+            Application::giveFocus(getDefaultFocus());
+            naturalScrollingCanScroll = false;
+        }
+    });
+
+    setHideHighlightBackground(true);
+    setHideHighlightBorder(true);
+
+    this->scrollingTimer.setPeriod(0);
+    this->scrollingTimer.setCallback([this]
+        { this->scrollingTick(); });
+}
+
+void ScrollView::onPanGesture(PanGestureStatus state)
+{
+    if (state.state == GestureState::FAILED || state.state == GestureState::UNSURE || state.state == GestureState::INTERRUPTED)
+        return;
+
+    // Mouse wheel, only the innermost scroll view gets it
+    if (state.deltaOnly)
+    {
+        this->dispatchNestedScroll(Point() - state.delta);
+        return;
+    }
+
+    if (state.state == GestureState::START)
+    {
+        Application::giveFocus(this);
+        this->panStartOffset = this->getContentOffset();
+        this->panOverflow    = Point();
+    }
+
+    if (state.state != GestureState::END)
+    {
+        Point move   = state.position - state.startPosition;
+        Point target = this->panStartOffset - move;
+
+        // Scroll what we can, the rest goes to the parent
+        Point overflow = move * -1.0f;
+
+        if (canScrollX())
+        {
+            float limit = getScrollLimit(true);
+            float x     = std::fmax(0.0f, std::fmin(target.x, limit));
+            overflow.x  = target.x - x;
+            startScrolling(false, true, x);
+        }
+
+        if (canScrollY())
+        {
+            float limit = getScrollLimit(false);
+            float y     = std::fmax(0.0f, std::fmin(target.y, limit));
+            overflow.y  = target.y - y;
+            startScrolling(false, false, y);
+        }
+
+        Point nestedDelta = overflow - this->panOverflow;
+        this->panOverflow = overflow;
+
+        ScrollView* parent = getParentScrollView();
+        if (parent && nestedDelta != Point())
+            parent->dispatchNestedScroll(nestedDelta);
+    }
+    else
+    {
+        this->dispatchNestedFling(state.acceleration.distance, state.acceleration.time * 1000.0f);
+    }
+}
+
+ScrollView* ScrollView::getParentScrollView()
+{
+    for (View* view = this->getParent(); view; view = view->getParent())
+    {
+        if (ScrollView* scrollView = dynamic_cast<ScrollView*>(view))
+            return scrollView;
+    }
+
+    return nullptr;
+}
+
+Point ScrollView::scrollBy(Point delta)
+{
+    Point remainder = delta;
+
+    if (canScrollX() && delta.x != 0)
+    {
+        float target = this->contentOffsetX + delta.x;
+        float x      = std::fmax(0.0f, std::fmin(target, getScrollLimit(true)));
+        remainder.x  = target - x;
+        startScrolling(false, true, x);
+    }
+
+    if (canScrollY() && delta.y != 0)
+    {
+        float target = this->contentOffsetY + delta.y;
+        float y      = std::fmax(0.0f, std::fmin(target, getScrollLimit(false)));
+        remainder.y  = target - y;
+        startScrolling(false, false, y);
+    }
+
+    return remainder;
+}
+
+void ScrollView::dispatchNestedScroll(Point delta)
+{
+    Point remainder = this->scrollBy(delta);
+
+    ScrollView* parent = getParentScrollView();
+    if (parent && remainder != Point())
+        parent->dispatchNestedScroll(remainder);
+}
+
+void ScrollView::dispatchNestedFling(Point distance, Point time)
+{
+    Point nestedDistance = distance;
+    Point nestedTime     = time;
+
+    for (bool horizontal : { true, false })
+    {
+        if (horizontal ? !canScrollX() : !canScrollY())
+            continue;
+
+        float current  = horizontal ? this->contentOffsetX : this->contentOffsetY;
+        float delta    = horizontal ? distance.x : distance.y;
+        float duration = horizontal ? time.x : time.y;
+        float limit    = getScrollLimit(horizontal);
+
+        // Already against the edge the fling goes to, let the parent have it
+        if ((delta < 0 && current <= 0) || (delta > 0 && current >= limit))
+            continue;
+
+        (horizontal ? nestedDistance.x : nestedDistance.y) = 0;
+
+        float target = std::fmax(0.0f, std::fmin(current + delta, limit));
+
+        if (this->snapToItems)
+        {
+            // Settle on the item closest to where the fling would have stopped
+            target   = findSnapPoint(horizontal, target);
+            duration = std::fmax(duration, (float)Application::getStyle()["brls/animations/highlight"]);
+        }
+        else if (target == current || duration < MIN_FLING_TIME)
+        {
+            continue;
+        }
+
+        if (target != current)
+            animateScrolling(horizontal, target, duration);
+    }
+
+    ScrollView* parent = getParentScrollView();
+    if (parent && nestedDistance != Point())
+        parent->dispatchNestedFling(nestedDistance, nestedTime);
+}
+
+float ScrollView::findSnapPoint(bool horizontal, float offset)
+{
+    Box* box = dynamic_cast<Box*>(this->contentView);
+    if (!box)
+        return offset;
+
+    float limit   = getScrollLimit(horizontal);
+    float closest = limit;
+
+    for (View* child : box->getChildren())
+    {
+        float point = std::fmin(horizontal ? child->getLocalX() : child->getLocalY(), limit);
+        if (std::fabs(point - offset) < std::fabs(closest - offset))
+            closest = point;
+    }
+
+    return std::fmax(0.0f, closest);
+}
+
+void ScrollView::updateScrollVelocity()
+{
+    Time now     = FrameClock::getFrameTime();
+    Point offset = this->getContentOffset();
+
+    if (this->lastVelocityTime != 0 && now > this->lastVelocityTime)
+    {
+        float seconds  = (now - this->lastVelocityTime) / 1000000.0f;
+        Point velocity = (offset - this->lastVelocityOffset) / seconds;
+
+        this->scrollVelocity = this->scrollVelocity * VELOCITY_SMOOTHING + velocity * (1.0f - VELOCITY_SMOOTHING);
+
+        // Settle, so that the ticking can stop
+        if (std::fabs(this->scrollVelocity.x) < 1.0f && std::fabs(this->scrollVelocity.y) < 1.0f)
+            this->scrollVelocity = Point();
+    }
+
+    this->lastVelocityOffset = offset;
+    this->lastVelocityTime   = now;
+}
+
+Rect ScrollView::getPrefetchFrame()
+{
+    Rect frame = Rect(this->getContentOffset(), Size(this->getWidth(), this->getHeight()));
+
+    if (this->prefetchDistance <= 0.0f)
+        return frame;
+
+    for (bool horizontal : { true, false })
+    {
+        if (horizontal ? !canScrollX() : !canScrollY())
+            continue;
+
+        float velocity = horizontal ? this->scrollVelocity.x : this->scrollVelocity.y;
+        float ahead    = this->prefetchDistance + std::fabs(velocity) * PREFETCH_VELOCITY_TIME;
+        float before   = 0.0f;
+        float after    = 0.0f;
+
+        // Only look ahead when scrolling, both ways when idle
+        if (velocity > 1.0f)
+            after = ahead;
+        else if (velocity < -1.0f)
+            before = ahead;
+        else
+            before = after = this->prefetchDistance;
+
+        if (horizontal)
+        {
+            frame.origin.x -= before;
+            frame.size.width += before + after;
+        }
+        else
+        {
+            frame.origin.y -= before;
+            frame.size.height += before + after;
+        }
+    }
+
+    return frame;
+}
+
+void ScrollView::prefetchContent()
+{
+    Box* box = dynamic_cast<Box*>(this->contentView);
+
+    if (this->prefetchDistance <= 0.0f || !box)
+    {
+        this->prefetchedViews.clear();
+        return;
+    }
+
+    Rect prefetchFrame                = this->getPrefetchFrame();
+    const std::vector<View*>& children = box->getChildren();
+
+    // Indexes moved, every child in the area is new
+    if (children.size() != this->prefetchedChildrenCount)
+        this->prefetchedViews.clear();
+    this->prefetchedChildrenCount = children.size();
+
+    // Pushed in order so that it stays sorted, in a vector reused from the previous ticks
+    this->nextPrefetchedViews.clear();
+
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        View* child = children[i];
+        if (child->getVisibility() == Visibility::GONE || !child->getLocalFrame().collideWith(prefetchFrame))
+            continue;
+
+        this->nextPrefetchedViews.push_back(i);
+
+        if (!std::binary_search(this->prefetchedViews.begin(), this->prefetchedViews.end(), i))
+            child->willBecomeVisible();
+    }
+
+    this->prefetchedViews.swap(this->nextPrefetchedViews);
+}
+
+void ScrollView::requestPrefetch()
+{
+    this->prefetchPending = true;
+    this->startScrollingTick();
+}
+
+void ScrollView::setupScrollingIndicators()
+{
+    Theme theme = Application::getTheme();
+
+    verticalScrollingIndicator = new Rectangle(theme["brls/text"]);
+    verticalScrollingIndicator->setSize(Size(SCROLLING_INDICATOR_SIZE, 0));
+    verticalScrollingIndicator->setCornerRadius(SCROLLING_INDICATOR_SIZE / 2);
+    verticalScrollingIndicator->detach();
+    Box::addView(verticalScrollingIndicator);
+
+    horizontalScrollingIndicator = new Rectangle(theme["brls/text"]);
+    horizontalScrollingIndicator->setSize(Size(0, SCROLLING_INDICATOR_SIZE));
+    horizontalScrollingIndicator->setCornerRadius(SCROLLING_INDICATOR_SIZE / 2);
+    horizontalScrollingIndicator->detach();
+    Box::addView(horizontalScrollingIndicator);
+}
+
+void ScrollView::updateScrollingIndicators()
+{
+    float contentWidth  = getContentWidth();
+    float contentHeight = getContentHeight();
+    float viewWidth     = getWidth();
+    float viewHeight    = getHeight();
+
+    if (!canScrollY() || contentHeight <= viewHeight || !showScrollingIndicator)
+    {
+        verticalScrollingIndicator->setAlpha(0);
+    }
+    else
+    {
+        verticalScrollingIndicator->setAlpha(0.3f);
+
+        // Only relayout when the size changes, this runs every frame
+        float indicatorHeight = viewHeight / contentHeight * viewHeight;
+        if (YGNodeStyleGetHeight(verticalScrollingIndicator->getYGNode()).value != indicatorHeight)
+            verticalScrollingIndicator->setHeight(indicatorHeight);
+
+        float scrollViewOffset = getContentOffsetY() / contentHeight * viewHeight;
+        verticalScrollingIndicator->setDetachedPosition(viewWidth - SCROLLING_INDICATOR_MARGIN - SCROLLING_INDICATOR_SIZE, scrollViewOffset);
+    }
+
+    if (!canScrollX() || contentWidth <= viewWidth || !showScrollingIndicator)
+    {
+        horizontalScrollingIndicator->setAlpha(0);
+    }
+    else
+    {
+        horizontalScrollingIndicator->setAlpha(0.3f);
+
+        float indicatorWidth = viewWidth / contentWidth * viewWidth;
+        if (YGNodeStyleGetWidth(horizontalScrollingIndicator->getYGNode()).value != indicatorWidth)
+            horizontalScrollingIndicator->setWidth(indicatorWidth);
+
+        float scrollViewOffset = getContentOffsetX() / contentWidth * viewWidth;
+        horizontalScrollingIndicator->setDetachedPosition(scrollViewOffset, viewHeight - SCROLLING_INDICATOR_MARGIN - SCROLLING_INDICATOR_SIZE);
+    }
+}
+
+void ScrollView::scrollingTick()
+{
+    naturalScrollingBehaviour();
+
+    // Update scrolling - try until it works
+    if (this->updateScrollingOnNextFrame && this->updateScrolling(false))
+        this->updateScrollingOnNextFrame = false;
+
+    // Here rather than in draw(), which partial redraw can skip
+    bool moving = this->getContentOffset() != this->lastVelocityOffset || this->scrollVelocity != Point();
+    this->updateScrollVelocity();
+
+    if (moving || this->prefetchPending)
+        this->prefetchContent();
+    this->prefetchPending = false;
+
+    // Idle frames do not run the ticking at all
+    if (!this->needsScrollingTick())
+        this->scrollingTimer.stop();
+}
+
+bool ScrollView::needsScrollingTick()
+{
+    // Natural scrolling polls the held buttons until they are released
+    if (this->behavior == ScrollingBehavior::NATURAL && this->naturalScrollingCanScroll && (this->focused || this->childFocused)
+        && Application::getInputType() != InputType::TOUCH)
+        return true;
+
+    // Velocity is tracked until the content stops moving
+    if (this->getContentOffset() != this->lastVelocityOffset || this->scrollVelocity != Point() || this->prefetchPending)
+        return true;
+
+    return this->updateScrollingOnNextFrame && this->contentView;
+}
+
+void ScrollView::startScrollingTick()
+{
+    if (this->needsScrollingTick())
+        this->scrollingTimer.start();
+}
+
+void ScrollView::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+{
+    updateScrollingIndicators();
+
+    // Enable scissoring
+    nvgSave(vg);
+    nvgIntersectScissor(vg, x, y, width, height);
+
+    // Draw children
+    Box::draw(vg, x, y, width, height, style, ctx);
+
+    //Disable scissoring
+    nvgRestore(vg);
+}
+
+void ScrollView::naturalScrollingBehaviour()
+{
+    if (behavior != ScrollingBehavior::NATURAL || Application::getInputType() == InputType::TOUCH)
+        return;
+
+    if (focused || childFocused)
+    {
+        // If current focus view is outside scrolling bounds,
+        // change focus to this.
+        View* currentFocus = Application::getCurrentFocus();
+        if (!currentFocus->getFrame().inscribed(getFrame()))
+        {
+            Application::giveFocus(this);
+        }
+
+        // If current focus equals this (a.k. no focus inside scroll),
+        // try to find the closest to the top focusable view and set it as current focus.
+        if (Application::getCurrentFocus() == this && Application::getInputType() == InputType::GAMEPAD)
+        {
+            View* firstView = findFirstFocusableView();
+
+            if (firstView && firstView != currentFocus)
+            {
+                Application::giveFocus(firstView);
+                Application::getAudioPlayer()->play(Sound::SOUND_FOCUS_CHANGE);
+            }
+        }
+    }
+
+    if (!naturalScrollingCanScroll)
+        return;
+
+    if (focused || childFocused)
+    {
+        ControllerState state {};
+        input->updateUnifiedControllerState(&state);
+
+        bool pressed = false;
+
+        if (canScrollX())
+            pressed |= naturalScrollingAxis(state, true);
+
+        if (canScrollY())
+            pressed |= naturalScrollingAxis(state, false);
+
+        // If there is focus inside scroll, and navigation buttons are not pressed
+        // disable natural scrolling
+        View* currentFocus = Application::getCurrentFocus();
+        if (!pressed && (currentFocus != this))
+        {
+            naturalScrollingCanScroll = false;
+        }
+
+        // If navigation buttons are not pressed and content offset not above border
+        // unflag repeat value to play border hit sound if needed
+        bool insideX = !canScrollX() || (getContentOffsetX() > 0.01f && getContentOffsetX() < getScrollLimit(true));
+        bool insideY = !canScrollY() || (getContentOffsetY() > 0.01f && getContentOffsetY() < getScrollLimit(false));
+        if (!pressed || (insideX && insideY))
+        {
+            naturalScrollingRepeat = false;
+        }
+    }
+}
+
+bool ScrollView::naturalScrollingAxis(const ControllerState& state, bool horizontal)
+{
+    ControllerButton backward = horizontal ? BUTTON_NAV_LEFT : BUTTON_NAV_UP;
+    ControllerButton forward  = horizontal ? BUTTON_NAV_RIGHT : BUTTON_NAV_DOWN;
+
+    // Do nothing if both buttons pressed simultaneously
+    if (state.buttons[backward] && state.buttons[forward])
+        return true;
+
+    if (state.buttons[forward])
+        naturalScrollingButtonProcessing(horizontal ? FocusDirection::RIGHT : FocusDirection::DOWN);
+
+    if (state.buttons[backward])
+        naturalScrollingButtonProcessing(horizontal ? FocusDirection::LEFT : FocusDirection::UP);
+
+    return state.buttons[backward] || state.buttons[forward];
+}
+
+View* ScrollView::findFirstFocusableView()
+{
+    if (!contentView)
+        return nullptr;
+
+    Rect frame = getFrame();
+    Point check;
+    FocusDirection direction;
+
+    switch (axis)
+    {
+        case ScrollAxis::HORIZONTAL:
+            check     = Point(frame.getMinX(), frame.getMidY());
+            direction = FocusDirection::RIGHT;
+            break;
+        case ScrollAxis::VERTICAL:
+            check     = Point(frame.getMidX(), frame.getMinY());
+            direction = FocusDirection::DOWN;
+            break;
+        default:
+            check     = Point(frame.getMinX(), frame.getMinY());
+            direction = FocusDirection::DOWN;
+            break;
+    }
+
+    View* focusCheck = contentView->hitTest(check);
+    if (focusCheck)
+    {
+        View* focusCheckDefaultFocus = focusCheck->getDefaultFocus();
+        if (focusCheckDefaultFocus)
+            focusCheck = focusCheckDefaultFocus;
+
+        while (focusCheck && !focusCheck->getFrame().inscribed(frame))
+        {
+            focusCheck = focusCheck->getParent()->getNextFocus(direction, focusCheck);
+        }
+
+        return focusCheck;
+    }
+
+    return nullptr;
+}
+
+void ScrollView::naturalScrollingButtonProcessing(FocusDirection focusDirection)
+{
+    bool horizontal = isHorizontal(focusDirection);
+    float limit     = this->getScrollLimit(horizontal);
+    float offset    = horizontal ? getContentOffsetX() : getContentOffsetY();
+    float newOffset = offset;
+    bool isBorder   = false;
+
+    // Follows the frame clock, so that fixed steps and replays scroll the same distance
+    float step = NATURAL_SCROLLING_SPEED * FrameClock::getFrameDelta() / 1000000.0f;
+
+    switch (focusDirection)
+    {
+        case FocusDirection::UP:
+        case FocusDirection::LEFT:
+            isBorder = offset <= 0;
+            newOffset -= step;
+            break;
+        case FocusDirection::DOWN:
+        case FocusDirection::RIGHT:
+            isBorder = offset >= limit;
+            newOffset += step;
+            break;
+        default:
+            break;
+    }
+
+    startScrolling(false, horizontal, newOffset);
+    View* current = Application::getCurrentFocus();
+    View* next    = current->getParent()->getNextFocus(focusDirection, current);
+    if (next)
+    {
+        if (current != next->getDefaultFocus())
+        {
+            Application::giveFocus(next);
+            if (next != this)
+                Application::getAudioPlayer()->play(SOUND_FOCUS_CHANGE);
+        }
+    }
+    else if (!current->getFrame().inscribed(getFrame()))
+    {
+        Application::giveFocus(this);
+    }
+
+    if (isBorder && !naturalScrollingRepeat)
+    {
+        naturalScrollingRepeat = true;
+        Application::getCurrentFocus()->shakeHighlight(focusDirection);
+        Application::getAudioPlayer()->play(SOUND_FOCUS_ERROR);
+    }
+}
+
+void ScrollView::addView(View* view)
+{
+    this->setContentView(view);
+}
+
+void ScrollView::removeView(View* view, bool free)
+{
+    this->setContentView(nullptr);
+}
+
+void ScrollView::setContentView(View* view)
+{
+    if (this->contentView)
+    {
+        Box::removeView(this->contentView); // will delete and call willDisappear
+        this->contentView = nullptr;
+    }
+
+    if (!view)
+        return;
+
+    // Setup the view and add it
+    this->contentView       = view;
+    this->contentLayoutSize = Size();
+
+    view->detach();
+    view->setCulled(false);
+
+    if (axis == ScrollAxis::VERTICAL)
+        view->setWidth(this->getWidth());
+    else if (axis == ScrollAxis::HORIZONTAL)
+        view->setHeight(this->getHeight());
+
+    Box::addView(view); // will invalidate the scrolling box, hence calling onLayout and invalidating the contentView
+
+    this->requestPrefetch();
+}
+
+void ScrollView::setScrollAxis(ScrollAxis axis)
+{
+    this->axis = axis;
+    this->scrollGesture->setAxis(getPanAxis(axis));
+
+    this->contentLayoutSize = Size();
+    this->invalidate();
+}
+
+void ScrollView::onLayout()
+{
+    if (!this->contentView)
+        return;
+
+    // Only relayout the content view if the viewport changed
+    Size size = Size(this->getWidth(), this->getHeight());
+    if (size == this->contentLayoutSize)
+        return;
+
+    this->contentLayoutSize = size;
+
+    if (axis == ScrollAxis::VERTICAL)
+        this->contentView->setWidth(size.width);
+    else if (axis == ScrollAxis::HORIZONTAL)
+        this->contentView->setHeight(size.height);
+    else
+        this->contentView->invalidate();
+
+    this->scrollAnimationTick();
+}
+
+void ScrollView::willAppear(bool resetState)
+{
+    // First scroll all the way to the top
+    // then wait for the first frame to scroll
+    // to the selected view if needed (only known then)
+    if (resetState && behavior == ScrollingBehavior::CENTERED)
+    {
+        this->updateScrollingOnNextFrame = true; // focus may have changed since
+    }
+
+    Box::willAppear(resetState);
+
+    this->requestPrefetch();
+}
+
+void ScrollView::willDisappear(bool resetState)
+{
+    Box::willDisappear(resetState);
+
+    this->scrollingTimer.stop();
+}
+
+void ScrollView::startScrolling(bool animated, bool horizontal, float newScroll)
+{
+    Animatable& offset = horizontal ? this->contentOffsetX : this->contentOffsetY;
+
+    if (newScroll == offset)
+        return;
+
+    if (animated)
+    {
+        Style style = Application::getStyle();
+        animateScrolling(horizontal, newScroll, style["brls/animations/highlight"]);
+    }
+    else
+    {
+        offset.stop();
+        offset = newScroll;
+        this->scrollAnimationTick();
+    }
+}
+
+void ScrollView::animateScrolling(bool horizontal, float newScroll, float time)
+{
+    Animatable& offset = horizontal ? this->contentOffsetX : this->contentOffsetY;
+
+    offset.stop();
+
+    offset.reset();
+
+    offset.addStep(newScroll, time, EasingFunction::quadraticOut);
+
+    offset.setTickCallback([this] {
+        this->scrollAnimationTick();
+    });
+
+    offset.start();
+}
+
+void ScrollView::setScrollingBehavior(ScrollingBehavior behavior)
+{
+    this->behavior = behavior;
+    this->startScrollingTick();
+}
+
+float ScrollView::getContentWidth()
+{
+    if (!this->contentView)
+        return 0;
+
+    return this->contentView->getWidth();
+}
+
+float ScrollView::getContentHeight()
+{
+    if (!this->contentView)
+        return 0;
+
+    return this->contentView->getHeight();
+}
+
+float ScrollView::getScrollLimit(bool horizontal)
+{
+    float limit = horizontal ? this->getContentWidth() - this->getWidth() : this->getContentHeight() - this->getHeight();
+    return std::fmax(0.0f, limit);
+}
+
+void ScrollView::setContentOffset(Point value, bool animated)
+{
+    startScrolling(animated, true, value.x);
+    startScrolling(animated, false, value.y);
+}
+
+void ScrollView::setContentOffsetX(float value, bool animated)
+{
+    startScrolling(animated, true, value);
+}
+
+void ScrollView::setContentOffsetY(float value, bool animated)
+{
+    startScrolling(animated, false, value);
+}
+
+void ScrollView::scrollAnimationTick()
+{
+    if (!canScrollX() || this->contentOffsetX < 0)
+        this->contentOffsetX = 0;
+
+    if (!canScrollY() || this->contentOffsetY < 0)
+        this->contentOffsetY = 0;
+
+    if (this->contentOffsetX > getScrollLimit(true))
+        this->contentOffsetX = getScrollLimit(true);
+
+    if (this->contentOffsetY > getScrollLimit(false))
+        this->contentOffsetY = getScrollLimit(false);
+
+    if (this->contentView)
+    {
+        // Only a translation, the layout of the content does not change
+        this->contentView->setTranslationX(-this->contentOffsetX);
+        this->contentView->setTranslationY(-this->contentOffsetY);
+        this->invalidateLayer();
+    }
+
+    // Tracks the velocity and prefetches while the offset moves
+    this->startScrollingTick();
+}
+
+View* ScrollView::getNextFocus(FocusDirection direction, View* currentView)
+{
+    // To prevent sound click on empty scroll view
+    if (isHorizontal(direction) ? canScrollX() : canScrollY())
+    {
+        float limit  = this->getScrollLimit(isHorizontal(direction));
+        float offset = isHorizontal(direction) ? this->getContentOffsetX() : this->getContentOffsetY();
+
+        if ((direction == FocusDirection::DOWN || direction == FocusDirection::RIGHT) && offset < (limit - 0.01f))
+            return this;
+
+        if ((direction == FocusDirection::UP || direction == FocusDirection::LEFT) && offset > 0.01f)
+            return this;
+    }
+
+    return Box::getNextFocus(direction, currentView);
+}
+
+View* ScrollView::getDefaultFocus()
+{
+    if (!contentView)
+        return Box::getDefaultFocus();
+
+    if (behavior == ScrollingBehavior::CENTERED)
+    {
+        View* focus = contentView->getDefaultFocus();
+        if (focus)
+            return focus;
+        else
+            return Box::getDefaultFocus();
+    }
+
+    View* focus = contentView->getDefaultFocus();
+    if (focus && focus->getFrame().inscribed(getFrame()))
+        return focus;
+
+    if (focus = findFirstFocusableView(); focus && focus != this)
+        return focus;
+
+    return Box::getDefaultFocus();
+}
+
+void ScrollView::onFocusGained()
+{
+    Box::onFocusGained();
+    naturalScrollingCanScroll = true;
+    this->startScrollingTick();
+}
+
+void ScrollView::onChildFocusGained(View* directChild, View* focusedView)
+{
+    Box::onChildFocusGained(directChild, focusedView);
+
+    this->childFocused = true;
+
+    // Start scrolling
+    if (Application::getInputType() == InputType::GAMEPAD && behavior == ScrollingBehavior::CENTERED)
+        this->updateScrolling(true);
+}
+
+void ScrollView::onChildFocusLost(View* directChild, View* focusedView)
+{
+    this->childFocused = false;
+}
+
+View* ScrollView::getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction)
+{
+    if (behavior == ScrollingBehavior::CENTERED)
+        return Box::getParentNavigationDecision(from, newFocus, direction);
+
+    View* currentFocus = Application::getCurrentFocus();
+    if (!newFocus)
+    {
+        if (isHorizontal(direction) ? !canScrollX() : !canScrollY())
+            return nullptr;
+
+        if (from == contentView)
+        {
+            naturalScrollingCanScroll = true;
+            this->startScrollingTick();
+            if (currentFocus->getFrame().inscribed(this->getFrame()))
+                return currentFocus;
+
+            return this;
+        }
+        return nullptr;
+    }
+    else
+    {
+        if (newFocus->getFrame().inscribed(this->getFrame()))
+            return newFocus;
+
+        naturalScrollingCanScroll = true;
+        this->startScrollingTick();
+    }
+
+    if (currentFocus->getFrame().inscribed(this->getFrame()))
+        return currentFocus;
+
+    return this;
+}
+
+bool ScrollView::updateScrolling(bool animated)
+{
+    if (!this->contentView)
+        return false;
+
+    View* focusedView = getDefaultFocus();
+    float localX      = focusedView ? focusedView->getLocalX() : 0.0f;
+    float localY      = focusedView ? focusedView->getLocalY() : 0.0f;
+    float itemWidth   = focusedView ? focusedView->getWidth() : 0.0f;
+    float itemHeight  = focusedView ? focusedView->getHeight() : 0.0f;
+    View* parent      = focusedView ? focusedView->getParent() : nullptr;
+
+    // Position of the focused view in the content view
+    while (parent && parent->getParent() && parent->getParent() != this)
+    {
+        localX += parent->getLocalX();
+        localY += parent->getLocalY();
+        parent = parent->getParent();
+    }
+
+    float newScrollX = std::fmax(0.0f, std::fmin(localX + itemWidth / 2 - this->getWidth() / 2, getScrollLimit(true)));
+    float newScrollY = std::fmax(0.0f, std::fmin(localY + itemHeight / 2 - this->getHeight() / 2, getScrollLimit(false)));
+
+    //Start animation
+    if (canScrollX())
+        this->startScrolling(animated, true, newScrollX);
+
+    if (canScrollY())
+        this->startScrolling(animated, false, newScrollY);
+
+    return true;
+}
+
+Rect ScrollView::getVisibleFrame()
+{
+    Rect frame = getLocalFrame();
+    frame.origin.x += this->contentOffsetX;
+    frame.origin.y += this->contentOffsetY;
+    return frame;
+}
+
+enum Sound ScrollView::getFocusSound()
+{
+    if (!contentView || !contentView->getDefaultFocus())
+    {
+        return Box::getFocusSound();
+    }
+    return Sound::SOUND_NONE;
+}
+
+#define NO_PADDING fatal("Padding is not supported by scrolling frames, please set padding on the content view instead");
+
+void ScrollView::setPadding(float top, float right, float bottom, float left)
+{
+    NO_PADDING
+}
+
+void ScrollView::setPaddingTop(float top)
+{
+    NO_PADDING
+}
+
+void ScrollView::setPaddingRight(float right)
+{
+    NO_PADDING
+}
+
+void ScrollView::setPaddingBottom(float bottom)
+{
+    NO_PADDING
+}
+
+void ScrollView::setPaddingLeft(float left)
+{
+    NO_PADDING
+}
+
+View* ScrollView::create()
+{
+    return new ScrollView();
+}
+
+ScrollView::~ScrollView()
+{
+    Application::getGlobalInputTypeChangeEvent()->unsubscribe(inputTypeSubscription);
+}
+
+} // namespace brls
@@ -110,6 +110,23 @@ Slider::Slider()
         PanAxis::HORIZONTAL));
 
     progress = 0.33f;
+
+    // Held buttons move the pointer every frame while it is focused, even if nothing else is drawn
+    buttonsTimer.setPeriod(0);
+    buttonsTimer.setCallback([this]
+        { this->buttonsProcessing(); });
+}
+
+void Slider::onChildFocusGained(View* directChild, View* focusedView)
+{
+    Box::onChildFocusGained(directChild, focusedView);
+    buttonsTimer.start();
+}
+
+void Slider::onChildFocusLost(View* directChild, View* focusedView)
+{
+    Box::onChildFocusLost(directChild, focusedView);
+    buttonsTimer.stop();
 }
 
 void Slider::onLayout()
@@ -123,12 +140,6 @@ View* Slider::getDefaultFocus()
     return pointer;
 }
 
-void Slider::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
-{
-    buttonsProcessing();
-    Box::draw(vg, x, y, width, height, style, ctx);
-}
-
 void Slider::buttonsProcessing()
 {
     if (pointer->isFocused())
@@ -140,9 +151,12 @@ void Slider::buttonsProcessing()
         if (state.buttons[BUTTON_NAV_RIGHT] && state.buttons[BUTTON_NAV_LEFT])
             return;
 
+        // step is per second, follow the frame clock so that replays move the same
+        float frameStep = step * FrameClock::getFrameDelta() / 1000000.0f;
+
         if (state.buttons[BUTTON_NAV_RIGHT])
         {
-            setProgress(progress += step / Application::getFPS());
+            setProgress(progress += frameStep);
             if (progress >= 1 && !repeat)
             {
                 repeat = true;
@@ -153,7 +167,7 @@ void Slider::buttonsProcessing()
 
         if (state.buttons[BUTTON_NAV_LEFT])
         {
-            setProgress(progress -= step / Application::getFPS());
+            setProgress(progress -= frameStep);
             if (progress <= 0 && !repeat)
             {
                 repeat = true;
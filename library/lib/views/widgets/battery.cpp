@@ -46,28 +46,73 @@ BatteryWidget::BatteryWidget()
 
     addView(level);
     addView(back);
+
+    // Poll the battery every 5s, the views are only changed when the state changes
+    this->applyState();
+    this->updateState();
+    this->pollTimer.setPeriod(5000);
+    this->pollTimer.setCallback([this]
+        { this->updateState(); });
+}
+
+void BatteryWidget::willAppear(bool resetState)
+{
+    Box::willAppear(resetState);
+
+    // Only polled while shown, catch up with what other widgets polled meanwhile
+    if (isBatteryCharging != this->appliedCharging || batteryLevel != this->appliedLevel)
+        this->applyState();
+
+    this->updateState();
+    this->pollTimer.start();
+}
+
+void BatteryWidget::willDisappear(bool resetState)
+{
+    Box::willDisappear(resetState);
+    this->pollTimer.stop();
 }
 
 void BatteryWidget::updateState()
 {
-    static Time time = 0;
-    Time now         = getCPUTimeUsec();
-    if ((now - time) > 5000000)
-    {
-        brls::Logger::verbose("isBatteryCharging: {}; batteryLevel: {}", isBatteryCharging, batteryLevel);
+    brls::Logger::verbose("isBatteryCharging: {}; batteryLevel: {}", isBatteryCharging, batteryLevel);
 #ifdef ANDROID
-        isBatteryCharging = Application::getPlatform()->isBatteryCharging();
-        batteryLevel      = Application::getPlatform()->getBatteryLevel() / 100.0f;
+    isBatteryCharging = Application::getPlatform()->isBatteryCharging();
+    batteryLevel      = Application::getPlatform()->getBatteryLevel() / 100.0f;
+
+    if (isBatteryCharging != this->appliedCharging || batteryLevel != this->appliedLevel)
+        this->applyState();
 #else
-        ASYNC_RETAIN
-        brls::async([ASYNC_TOKEN]()
-            {
-                ASYNC_RELEASE
-                isBatteryCharging = Application::getPlatform()->isBatteryCharging();
-                batteryLevel      = Application::getPlatform()->getBatteryLevel() / 100.0f; });
+    ASYNC_RETAIN
+    brls::async([ASYNC_TOKEN]()
+        {
+            bool charging = Application::getPlatform()->isBatteryCharging();
+            float level   = Application::getPlatform()->getBatteryLevel() / 100.0f;
+
+            brls::sync([ASYNC_TOKEN, charging, level]()
+                {
+                    ASYNC_RELEASE
+                    isBatteryCharging = charging;
+                    batteryLevel      = level;
+
+                    // The polled state is shared, compare it with what this widget shows
+                    if (charging != this->appliedCharging || level != this->appliedLevel)
+                        this->applyState(); }); });
 #endif
-        time = now;
-    }
+}
+
+void BatteryWidget::applyState()
+{
+    this->appliedTheme    = platform->getThemeVariant();
+    this->appliedCharging = isBatteryCharging;
+    this->appliedLevel    = batteryLevel;
+
+    if (isBatteryCharging)
+        level->setColor(RGB(140, 251, 79));
+    else
+        applyLevelTheme(this->appliedTheme);
+
+    level->setWidth(BATTERY_MAX_WIDTH * batteryLevel);
 }
 
 void BatteryWidget::applyBackTheme(ThemeVariant theme)
@@ -98,13 +143,10 @@ void BatteryWidget::applyLevelTheme(ThemeVariant theme)
 
 void BatteryWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
 {
-    this->updateState();
-    if (isBatteryCharging)
-        level->setColor(RGB(140, 251, 79));
-    else
-        applyLevelTheme(platform->getThemeVariant());
+    // Theme changes redraw everything, follow them here
+    if (platform->getThemeVariant() != this->appliedTheme)
+        this->applyState();
 
-    level->setWidth(BATTERY_MAX_WIDTH * batteryLevel);
     Box::draw(vg, x, y, width, height, style, ctx);
 }
 
@@ -69,6 +69,31 @@ WirelessWidget::WirelessWidget()
     addView(_2);
     addView(_3);
     addView(ethernet);
+
+    // Poll the connection every 5s, the views are only changed when the state changes
+    this->applyState();
+    this->updateState();
+    this->pollTimer.setPeriod(5000);
+    this->pollTimer.setCallback([this]
+        { this->updateState(); });
+}
+
+void WirelessWidget::willAppear(bool resetState)
+{
+    Box::willAppear(resetState);
+
+    // Only polled while shown, catch up with what other widgets polled meanwhile
+    if (!this->isStateApplied())
+        this->applyState();
+
+    this->updateState();
+    this->pollTimer.start();
+}
+
+void WirelessWidget::willDisappear(bool resetState)
+{
+    Box::willDisappear(resetState);
+    this->pollTimer.stop();
 }
 
 void WirelessWidget::applyTheme(ThemeVariant theme)
@@ -94,54 +119,69 @@ void WirelessWidget::applyTheme(ThemeVariant theme)
 
 void WirelessWidget::updateState()
 {
-    static Time time = 0;
-    Time now         = getCPUTimeUsec();
-    if ((now - time) > 5000000 || time == 0)
-    {
-        brls::Logger::verbose("hasWirelessConnection: {}; wifiLevel: {}", hasWirelessConnection, wifiLevel);
+    brls::Logger::verbose("hasWirelessConnection: {}; wifiLevel: {}", hasWirelessConnection, wifiLevel);
 #ifdef ANDROID
-        hasEthernetConnection = Application::getPlatform()->hasEthernetConnection();
-        hasWirelessConnection = Application::getPlatform()->hasWirelessConnection();
-        wifiLevel             = Application::getPlatform()->getWirelessLevel();
+    hasEthernetConnection = Application::getPlatform()->hasEthernetConnection();
+    hasWirelessConnection = Application::getPlatform()->hasWirelessConnection();
+    wifiLevel             = Application::getPlatform()->getWirelessLevel();
+
+    if (!this->isStateApplied())
+        this->applyState();
 #else
-        ASYNC_RETAIN
-        brls::async([ASYNC_TOKEN]()
-            {
-                ASYNC_RELEASE
+    ASYNC_RETAIN
+    brls::async([ASYNC_TOKEN]()
+        {
+            bool ethernetConnection, wirelessConnection;
+            int level;
 #ifdef __SWITCH__
-                // Reduce service calls
-                // and fix support for emulator (Ryujinx) as it doesn't support :
-                // nifmIsWirelessCommunicationEnabled() / nifmIsEthernetCommunicationEnabled().
-                NifmInternetConnectionType type;
-                u32 wifiSignal;
-                NifmInternetConnectionStatus status;
-                Result ret            = nifmGetInternetConnectionStatus(&type, &wifiSignal, &status);
-                hasEthernetConnection = type == NifmInternetConnectionType_Ethernet;
-                hasWirelessConnection = type == NifmInternetConnectionType_WiFi;
-                if (ret != 0)
-                {
-                    hasEthernetConnection = false;
-                    hasWirelessConnection = false;
-                    wifiLevel             = 0;
-                }
-                else
-                {
-                    wifiLevel = (int)wifiSignal;
-                }
+            // Reduce service calls
+            // and fix support for emulator (Ryujinx) as it doesn't support :
+            // nifmIsWirelessCommunicationEnabled() / nifmIsEthernetCommunicationEnabled().
+            NifmInternetConnectionType type;
+            u32 wifiSignal;
+            NifmInternetConnectionStatus status;
+            Result ret         = nifmGetInternetConnectionStatus(&type, &wifiSignal, &status);
+            ethernetConnection = type == NifmInternetConnectionType_Ethernet;
+            wirelessConnection = type == NifmInternetConnectionType_WiFi;
+            if (ret != 0)
+            {
+                ethernetConnection = false;
+                wirelessConnection = false;
+                level              = 0;
+            }
+            else
+            {
+                level = (int)wifiSignal;
+            }
 #else
-                hasEthernetConnection = Application::getPlatform()->hasEthernetConnection();
-                hasWirelessConnection = Application::getPlatform()->hasWirelessConnection();
-                wifiLevel             = Application::getPlatform()->getWirelessLevel();
+            ethernetConnection = Application::getPlatform()->hasEthernetConnection();
+            wirelessConnection = Application::getPlatform()->hasWirelessConnection();
+            level              = Application::getPlatform()->getWirelessLevel();
 #endif
-            });
+
+            brls::sync([ASYNC_TOKEN, ethernetConnection, wirelessConnection, level]()
+                {
+                    ASYNC_RELEASE
+                    hasEthernetConnection = ethernetConnection;
+                    hasWirelessConnection = wirelessConnection;
+                    wifiLevel             = level;
+
+                    // The polled state is shared, compare it with what this widget shows
+                    if (!this->isStateApplied())
+                        this->applyState(); }); });
 #endif
-        time = now;
-    }
 }
 
-void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+bool WirelessWidget::isStateApplied()
+{
+    return hasEthernetConnection == this->appliedEthernet && hasWirelessConnection == this->appliedWireless && wifiLevel == this->appliedLevel;
+}
+
+void WirelessWidget::applyState()
 {
-    updateState();
+    this->appliedEthernet = hasEthernetConnection;
+    this->appliedWireless = hasWirelessConnection;
+    this->appliedLevel    = wifiLevel;
 
     if (hasEthernetConnection)
     {
@@ -191,8 +231,6 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
                 break;
         }
     }
-
-    Box::draw(vg, x, y, width, height, style, ctx);
 }
 
 View* WirelessWidget::create()
@@ -0,0 +1,44 @@
+/*
+    Copyright 2023 xfangfang
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Compiles the translations of a locale to a binary catalog, without
+// initializing the application or opening a window. Ship the output as
+// "i18n/<locale>.catalog" in the resources.
+
+#include <borealis/core/i18n.hpp>
+#include <borealis/core/logger.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char* argv[])
+{
+    int arg = 1;
+
+    if (arg < argc && std::strcmp(argv[arg], "-d") == 0) // Set log level
+    {
+        brls::Logger::setLogLevel(brls::LogLevel::LOG_DEBUG);
+        arg++;
+    }
+
+    if (argc - arg != 2)
+    {
+        std::fprintf(stderr, "Usage: %s [-d] <locale> <output catalog>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return brls::compileTranslationsCatalog(argv[arg], argv[arg + 1]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
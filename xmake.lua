@@ -99,6 +99,7 @@ target("borealis")
         add_files("library/lib/platforms/glfw/driver/metal.mm")
         add_links("nanovg_metal")
     elseif driver == "opengl" then
+        add_files("library/lib/platforms/driver/gl_framebuffer.cpp")
         add_defines("BOREALIS_USE_OPENGL")
         add_packages("glad")
     elseif driver == "d3d11" then